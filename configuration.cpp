@@ -32,7 +32,12 @@
 #include "common/filesystem.hpp"
 #include "common/quantity.hpp"
 #include "common/system.hpp"
+#include "experiment/details/epoch_service.hpp"
+#include "experiment/details/hardware_counters.hpp"
+#include "experiment/details/synthetic_log.hpp"
+#include "experiment/details/thread_placement.hpp"
 #include "experiment/graphalytics.hpp"
+#include "experiment/insert_only.hpp"
 #include "library/interface.hpp"
 #include "reader/graphlog_reader.hpp"
 #include "third-party/cxxopts/cxxopts.hpp"
@@ -96,33 +101,73 @@ void Configuration::initialise(int argc, char* argv[]){
     Options options(argv[0], "GFE Driver");
 
     options.add_options("Generic")
+        ("aging_arrival", "Open-loop mode in the Aging2 experiment, the distribution of the inter-arrival times of the updates: constant or poisson", value<string>()->default_value(get_aging_arrival_process()))
+        ("aging_checkpoint", "Periodically save the progress of the Aging2 experiment in the given file, to resume it later with --aging_resume", value<string>())
+        ("aging_checkpoint_interval", "How often to save the progress of the Aging2 experiment with --aging_checkpoint", value<DurationQuantity>())
         ("aging_cooloff", "The amount of time to wait idle after the simulation completed in the Aging2 experiment. The purpose is to measure the memory footprint of the test library when no updates are being executed", value<DurationQuantity>())
+        ("aging_granularity", "Adapt the number of updates in each chunk of an Aging2 worker so that a chunk takes about the given time (default: 1 ms, 0 = fixed chunks of 1024 updates)", value<DurationQuantity>())
         ("aging_memfp", "Whether to measure the memory footprint", value<bool>()->default_value("false"))
         ("aging_memfp_physical", "Whether to consider the virtual or the physical memory in the memory footprint", value<bool>()->default_value("false"))
         ("aging_memfp_report", "Whether to log to stdout the memory footprint measurements observed", value<bool>()->default_value("false"))
         ("aging_memfp_threshold", "Forcedly stop the execution of the aging experiment if the memory footprint of the whole process is above this threshold", value<ComputerQuantity>())
+        ("aging_placement", "How to pin the worker threads of the Aging2 experiment to the logical CPUs: default, none, compact (fill one NUMA node at the time) or round_robin (among the NUMA nodes)", value<string>()->default_value(get_aging_worker_placement()))
+        ("aging_rate", "Open-loop mode in the Aging2 experiment, the target number of updates per second issued by each worker thread (default: closed loop)", value<double>())
+        ("aging_read_ratio", "Interleave point lookups with the updates in the Aging2 experiment, the fraction of operations that are reads in [0, 1)", value<double>()->default_value("0"))
+        ("aging_read_target", "The edges looked up by the point reads in the Aging2 experiment: recent (updated by the same worker) or random (from the log)", value<string>()->default_value(get_aging_read_target()))
         ("aging_release_memory", "Whether to release the memory from the driver as the experiment proceeds", value<bool>()->default_value("true"))
+        ("aging_resume", "Resume the Aging2 experiment from the checkpoint set with --aging_checkpoint")
         ("aging_step_size", "The step of each recording for the measured progress in the Aging2 experiment. Valid values are 0.1, 0.25, 0.5 and 1.0", value<double>()->default_value("1"))
+        ("aging_streaming", "Decode the updates of the Aging2 experiment while the experiment runs, rather than loading them all in memory upfront. The argument is the max number of blocks of updates queued for each worker", value<uint64_t>())
+        ("aging_synthetic", "Generate the updates of the Aging2 experiment in the driver from the final graph given with --graph, rather than reading a log file. The temporary edges follow the pattern: uniform, zipf (skewed sources), window (insert & expire after a fixed number of operations) or burst (periodic bursts of insertions)", value<string>())
+        ("aging_synthetic_burst", "With --aging_synthetic burst, the length of a period in number of operations (default: 1/10 of the operations)", value<uint64_t>()->default_value("0"))
+        ("aging_synthetic_coeff", "With --aging_synthetic, the total number of updates to perform w.r.t. the number of edges in the final graph", value<double>()->default_value("10"))
+        ("aging_synthetic_window", "With --aging_synthetic, the (average) number of operations a temporary edge stays in the graph (default: the number of edges in the graph)", value<uint64_t>()->default_value("0"))
+        ("aging_synthetic_zipf", "With --aging_synthetic zipf, the exponent of the Zipf distribution of the sources", value<double>()->default_value("1.0"))
+        ("aging_timeline", "Record the throughput and the latency of the updates in the Aging2 experiment in windows of the given length (min 100 ms)", value<DurationQuantity>())
         ("aging_timeout", "Force terminating the aging experiment after the given amount of time (excl. cool-off time)", value<DurationQuantity>())
+        ("analytic_clients", "In the mixed workload, the number of analytic clients running the Graphalytics suite concurrently, each with its own partition of the --readers threads", value<uint64_t>()->default_value(to_string(get_analytic_clients())))
         ("blacklist", "Comma separated list of graph algorithms to blacklist and do not execute", value<string>())
+        ("bulk_load", "Populate the library with its bulk loader, rather than measuring the insertions with the InsertOnly experiment. Useful to prepare the graph for the Graphalytics suite")
         ("build_frequency", "The frequency to build a new snapshot in the aging experiment (default: disabled)", value<DurationQuantity>())
+        ("calibrate", "Measure the overhead of the driver: execute the experiments InsertOnly, Aging2 and the Graphalytics suite with the library dummy_v3, where all operations are nop, with 1, 2, 4, ... up to --writers threads")
         ("d, database", "Store the current configuration value into the a sqlite3 database at the given location", value<string>())
         ("efe", "Expansion factor for the edges in the graph", value<double>()->default_value(to_string(get_ef_edges())))
         ("efv", "Expansion factor for the vertices in the graph", value<double>()->default_value(to_string(get_ef_vertices())))
+        ("epoch_frequency", "In the mixed workload, how frequently to create a new epoch (snapshot) in the library (default: 5s)", value<DurationQuantity>())
+        ("gc_budget", "In the mixed workload, a hint for the max amount of time of each invocation to the garbage collector of the library (default: unbounded). It is only a hint: none of the supported libraries can interrupt its garbage collector, hence they all ignore it", value<DurationQuantity>())
+        ("gc_frequency", "In the mixed workload, how frequently to invoke the garbage collector of the library, with the policy periodic (default: 500ms)", value<DurationQuantity>())
+        ("gc_graphalytics", "Whether to invoke the garbage collector of the library once before running the Graphalytics suite, to reclaim the versions left by the updates", value<bool>()->default_value("true"))
+        ("gc_policy", "In the mixed workload, when to invoke the garbage collector of the library: none, periodic (every --gc_frequency) or after_epoch (right after the creation of each epoch)", value<string>()->default_value(get_gc_policy()))
         ("G, graph", "The path to the graph to load", value<string>())
         ("h, help", "Show this help menu")
+        ("hardware_counters", "Record the hardware counters (cycles, instructions, LLC, dTLB and branch misses) of the worker threads for each phase of the experiment and each graphalytics kernel. It requires libpapi")
+        ("insertion_granularity", "The number of edges in each chunk handed to a worker by the scheduler of the InsertOnly experiment. With the scheduler guided, the minimum size of a chunk", value<uint64_t>()->default_value(to_string(get_insertion_granularity())))
+        ("insertion_order", "The order to insert the edges in the InsertOnly experiment: random (as the permuted stream), sorted_chunks (each chunk of a worker sorted by source) or vertex_partitioned (all edges of a source vertex inserted by the same worker)", value<string>()->default_value(get_insertion_order()))
+        ("insertion_placement", "How to pin the workers of the InsertOnly experiment to the logical CPUs: default, none, compact (fill one NUMA node at the time) or round_robin (among the NUMA nodes)", value<string>()->default_value(get_insertion_placement()))
+        ("insertion_scheduler", "How to distribute the edges among the workers of the InsertOnly experiment: static (one contiguous range per worker), dynamic (chunks of fixed size) or guided (chunks proportional to the remaining edges)", value<string>()->default_value(get_insertion_scheduler()))
+        ("insertion_timeline", "Record the throughput, the memory footprint and the invocations to #build() of the InsertOnly experiment in windows of the given length (min 100 ms)", value<DurationQuantity>())
         ("latency", "Measure the latency of inserts/updates, report the average, median, std. dev. and 90/95/97/99 percentiles")
+        ("latency_sampling", "In the insert only experiment, together with --latency, measure the latency of only one insertion every N insertions", value<uint64_t>()->default_value("1"))
         ("l, library", libraries_help_screen(), value<string>())
         ("load", "Load the graph into the library in one go")
         ("log", "Repeat the log of updates specified in the given file", value<string>())
         ("max_weight", "The maximum weight that can be assigned when reading non weighted graphs", value<double>()->default_value(to_string(max_weight())))
+        ("mixed_duration", "In the mixed workload, stop the analytics after the given amount of time (default: no limit)", value<DurationQuantity>())
+        ("mixed_iterations", "In the mixed workload, stop each analytic client after the given number of executions of the Graphalytics suite (0 = no limit)", value<uint64_t>()->default_value(to_string(get_mixed_iterations())))
+        ("mixed_stop", "In the mixed workload, stop the analytics once the writers performed the given fraction of all updates, in (0, 1]", value<double>()->default_value(to_string(get_mixed_stop_progress())))
+        ("mixed_warmup", "In the mixed workload, start the analytics once the writers performed the given fraction of all updates, in [0, 1)", value<double>()->default_value(to_string(get_mixed_warmup_progress())))
+        ("mixed_warmup_ops", "In the mixed workload, start the analytics once the writers performed at least the given number of updates", value<uint64_t>()->default_value(to_string(get_mixed_warmup_operations())))
         ("omp", "Maximum number of threads that can be used by OpenMP (0 = do not change)", value<int>()->default_value(to_string(num_threads_omp())))
         ("R, repetitions", "The number of repetitions of the same experiment (where applicable)", value<uint64_t>()->default_value(to_string(num_repetitions())))
         ("r, readers", "The number of client threads to use for the read operations", value<int>()->default_value(to_string(num_threads(THREADS_READ))))
         ("seed", "Random seed used in various places in the experiments", value<uint64_t>()->default_value(to_string(seed())))
+        ("sliding_window", "Stream the edges of the graph, in the order of the file, through a window retaining the given number of edges. Each insertion of a new edge removes the edge that left the window", value<uint64_t>())
+        ("sliding_window_gc", "How often to invoke the garbage collector of the library in the sliding window experiment (default: never)", value<DurationQuantity>())
+        ("sliding_window_passes", "How many times to replay the stream of edges in the sliding window experiment", value<uint64_t>()->default_value("1"))
         ("t, threads", "The number of threads to use for both the read and write operations", value<int>()->default_value(to_string(num_threads(THREADS_TOTAL))))
         ("timeout", "Set the maximum time for an operation to complete, in seconds", value<uint64_t>()->default_value(to_string(get_timeout_graphalytics())))
         ("u, undirected", "Is the graph undirected? By default, it's considered directed.")
+        ("update_batch_size", "The number of updates sent by each worker of the Aging2 experiment in a single batch to the library", value<uint64_t>()->default_value(to_string(get_aging_update_batch_size())))
         ("v, validate", "Whether to validate the output results of the Graphalytics algorithms", value<string>()->implicit_value("<path>"))
         ("w, writers", "The number of client threads to use for the write operations", value<int>()->default_value(to_string(num_threads(THREADS_WRITE))))
         ("b, block_size", "The block size for Sortledton to use.", value<int>()->default_value("1024"))
@@ -205,15 +250,21 @@ void Configuration::initialise(int argc, char* argv[]){
         if( result["efv"].count() > 0 )
             set_ef_vertices( result["efv"].as<double>() );
 
+        set_analytic_clients( result["analytic_clients"].as<uint64_t>() );
+
         if( result["build_frequency"].count() > 0 ){
             set_build_frequency( result["build_frequency"].as<DurationQuantity>().as<chrono::milliseconds>().count() );
         }
 
+        if( result["calibrate"].count() > 0 ){
+            m_calibrate = true;
+        }
+
         // library to evaluate
-        if( result["library"].count() == 0 ){
+        if( result["library"].count() == 0 && !is_calibration() ){
             ERROR("Missing mandatory argument --library. Which library do you want to evaluate??");
         } else {
-            string library_name = result["library"].as<string>();
+            string library_name = result["library"].count() > 0 ? result["library"].as<string>() : "dummy_v3"; // calibration => dummy_v3
             transform(begin(library_name), end(library_name), begin(library_name), ::tolower); // make it lower case
             auto libs = library::implementations();
             // std::cout<<libs.size()<<std::endl;
@@ -223,7 +274,7 @@ void Configuration::initialise(int argc, char* argv[]){
             auto library_found = find_if(begin(libs), end(libs), [&library_name](const auto& candidate){
                 return library_name == candidate.m_name;
             });
-            if(library_found == end(libs)){ ERROR("Library not recognised: `" << result["library"].as<string>() << "'"); }
+            if(library_found == end(libs)){ ERROR("Library not recognised: `" << library_name << "'"); }
             m_library_name = library_found->m_name;
             m_library_factory = library_found->m_factory;
         }
@@ -232,6 +283,11 @@ void Configuration::initialise(int argc, char* argv[]){
             set_load(true);
         }
 
+        if( result["bulk_load"].count() > 0 ){
+            if( is_load() ){ ERROR("The options --load and --bulk_load are mutually exclusive"); }
+            m_bulk_load = true;
+        }
+
         if( result["undirected"].count() > 0 ){
             m_graph_directed = false;
         }
@@ -260,6 +316,57 @@ void Configuration::initialise(int argc, char* argv[]){
             set_aging_step_size( result["aging_step_size"].as<double>() );
         }
 
+        if( result["aging_rate"].count() > 0 ){
+            set_aging_arrival_rate( result["aging_rate"].as<double>() );
+        }
+
+        set_aging_arrival_process( result["aging_arrival"].as<string>() );
+
+        set_aging_update_batch_size( result["update_batch_size"].as<uint64_t>() );
+
+        set_aging_worker_placement( result["aging_placement"].as<string>() );
+
+        set_aging_read_ratio( result["aging_read_ratio"].as<double>() );
+
+        set_aging_read_target( result["aging_read_target"].as<string>() );
+
+        if( result["aging_granularity"].count() > 0 ){
+            set_aging_granularity_target( result["aging_granularity"].as<DurationQuantity>().as<chrono::microseconds>().count() );
+        }
+
+        if( result["aging_timeline"].count() > 0 ){
+            set_aging_timeline_resolution( result["aging_timeline"].as<DurationQuantity>().as<chrono::milliseconds>().count() );
+        }
+
+        if( result["aging_checkpoint"].count() > 0 ){
+            uint64_t interval = get_aging_checkpoint_interval();
+            if( result["aging_checkpoint_interval"].count() > 0 ){
+                interval = result["aging_checkpoint_interval"].as<DurationQuantity>().as<chrono::seconds>().count();
+            }
+            set_aging_checkpoint( result["aging_checkpoint"].as<string>(), interval );
+        }
+
+        if( result["aging_resume"].count() > 0 ){
+            set_aging_resume( true );
+        }
+
+        if( result["aging_streaming"].count() > 0 ){
+            m_aging_streaming = result["aging_streaming"].as<uint64_t>();
+            if( m_aging_streaming > 0 && get_aging_resume() ){ ERROR("The option --aging_streaming cannot be used together with --aging_resume"); }
+            if( m_aging_streaming > 0 && !get_aging_checkpoint_path().empty() ){ ERROR("The option --aging_streaming cannot be used together with --aging_checkpoint"); }
+        }
+
+        if( result["aging_synthetic"].count() > 0 ){
+            if( !get_update_log().empty() ){ ERROR("Cannot specify the option --aging_synthetic together with the log file"); }
+            if( get_path_graph().empty() ){ ERROR("The option --aging_synthetic requires the final graph, set with the option --graph"); }
+            set_aging_synthetic( result["aging_synthetic"].as<string>() );
+            set_coeff_aging( result["aging_synthetic_coeff"].as<double>() );
+            if( coefficient_aging() < 1 ){ ERROR("The option --aging_synthetic_coeff must be >= 1: " << coefficient_aging()); }
+            set_aging_synthetic_zipf( result["aging_synthetic_zipf"].as<double>() );
+            m_aging_synthetic_window = result["aging_synthetic_window"].as<uint64_t>();
+            m_aging_synthetic_burst = result["aging_synthetic_burst"].as<uint64_t>();
+        }
+
         if( result["aging_cooloff"].count() > 0){
             set_aging_cooloff_seconds( result["aging_cooloff"].as<DurationQuantity>().as<chrono::seconds>().count() );
         }
@@ -271,6 +378,12 @@ void Configuration::initialise(int argc, char* argv[]){
         if(result.count("mixed_workload") > 0){
           m_is_mixed_workload = result["mixed_workload"].as<bool>();
         }
+        if( result["mixed_duration"].count() > 0 ){
+            m_mixed_duration = result["mixed_duration"].as<DurationQuantity>().as<chrono::milliseconds>().count();
+        }
+        m_mixed_iterations = result["mixed_iterations"].as<uint64_t>();
+        set_mixed_progress( result["mixed_warmup"].as<double>(), result["mixed_stop"].as<double>() );
+        m_mixed_warmup_operations = result["mixed_warmup_ops"].as<uint64_t>();
 
         if( result["aging_memfp_physical"].count() > 0 ){
             m_aging_memfp_physical = result["aging_memfp_physical"].as<bool>();
@@ -306,6 +419,33 @@ void Configuration::initialise(int argc, char* argv[]){
         } // blacklist
 
         m_measure_latency = result["latency"].count() > 0;
+        if( measure_latency() && get_aging_streaming() > 0 ){ ERROR("The option --aging_streaming cannot be used together with --latency"); }
+        if( result["epoch_frequency"].count() > 0 ){
+            set_epoch_frequency( result["epoch_frequency"].as<DurationQuantity>().as<chrono::milliseconds>().count() );
+        }
+        if( result["gc_budget"].count() > 0 ){
+            set_gc_budget( result["gc_budget"].as<DurationQuantity>().as<chrono::microseconds>().count() );
+        }
+        if( result["gc_frequency"].count() > 0 ){
+            set_gc_frequency( result["gc_frequency"].as<DurationQuantity>().as<chrono::milliseconds>().count() );
+        }
+        m_gc_graphalytics = result["gc_graphalytics"].as<bool>();
+        set_gc_policy( result["gc_policy"].as<string>() );
+        set_insertion_granularity( result["insertion_granularity"].as<uint64_t>() );
+        set_insertion_order( result["insertion_order"].as<string>() );
+        set_insertion_placement( result["insertion_placement"].as<string>() );
+        set_insertion_scheduler( result["insertion_scheduler"].as<string>() );
+        if( result["insertion_timeline"].count() > 0 ){
+            set_insertion_timeline_resolution( result["insertion_timeline"].as<DurationQuantity>().as<chrono::milliseconds>().count() );
+        }
+
+        m_latency_sampling = result["latency_sampling"].as<uint64_t>();
+        if( m_latency_sampling == 0 ){ ERROR("The option --latency_sampling must be > 0"); }
+
+        if( result["hardware_counters"].count() > 0 ){
+            if(!experiment::details::HardwareCountersThread::is_supported()){ ERROR("The option --hardware_counters requires the driver to be compiled with libpapi"); }
+            m_hardware_counters = true;
+        }
 
         if ( result["aging_timeout"].count() > 0 ){
             set_timeout_aging2( result["aging_timeout"].as<DurationQuantity>().as<chrono::seconds>().count() );
@@ -319,6 +459,15 @@ void Configuration::initialise(int argc, char* argv[]){
           set_is_timestamped( result["is_timestamped"].as<bool>() );
         }
 
+        if( result["sliding_window"].count() > 0 ){
+            if( !get_update_log().empty() || !get_aging_synthetic().empty() ){ ERROR("Cannot specify the option --sliding_window together with the Aging2 experiment"); }
+            uint64_t gc_frequency = 0;
+            if( result["sliding_window_gc"].count() > 0 ){
+                gc_frequency = result["sliding_window_gc"].as<DurationQuantity>().as<chrono::milliseconds>().count();
+            }
+            set_sliding_window( result["sliding_window"].as<uint64_t>(), result["sliding_window_passes"].as<uint64_t>(), gc_frequency );
+        }
+
     } catch ( argument_incorrect_type& e){
         ERROR(e.what());
     }
@@ -404,6 +553,11 @@ void Configuration::set_graph(const std::string& graph){
     m_path_graph_to_load = graph;
 }
 
+void Configuration::set_analytic_clients(uint64_t num_clients){
+    if(num_clients < 1){ ERROR("Invalid number of analytic clients: " << num_clients << ". Expected a value of at least 1"); }
+    m_analytic_clients = num_clients;
+}
+
 void Configuration::set_build_frequency( uint64_t millisecs ){
     m_build_frequency = millisecs;
 }
@@ -422,6 +576,122 @@ void Configuration::set_aging_step_size( double value ){
     m_step_size_recordings = value;
 }
 
+void Configuration::set_aging_arrival_rate(double ops_per_sec){
+    if(ops_per_sec < 0){ ERROR("Invalid value for the arrival rate: " << ops_per_sec << ". Expected a non negative value"); }
+    m_aging_arrival_rate = ops_per_sec;
+}
+
+void Configuration::set_aging_arrival_process(const std::string& process){
+    string value = process;
+    transform(begin(value), end(value), begin(value), ::tolower);
+    if(value != "constant" && value != "poisson"){ ERROR("Invalid value for the arrival process: `" << process << "'. Expected either constant or poisson"); }
+    m_aging_arrival_process = value;
+}
+
+void Configuration::set_aging_granularity_target(uint64_t microsecs){
+    if(microsecs > 10000000){ ERROR("Invalid value for the target time of a chunk of updates: " << microsecs << " us. Expected a value of at most 10 seconds"); }
+    m_aging_granularity_target = microsecs;
+}
+
+void Configuration::set_aging_read_ratio(double ratio){
+    if(ratio < 0 || ratio >= 1){ ERROR("Invalid value for the read ratio: " << ratio << ". Expected a value in [0, 1)"); }
+    m_aging_read_ratio = ratio;
+}
+
+void Configuration::set_aging_read_target(const std::string& target){
+    string value = target;
+    transform(begin(value), end(value), begin(value), ::tolower);
+    if(value != "recent" && value != "random"){ ERROR("Invalid value for the read target: `" << target << "'. Expected either recent or random"); }
+    m_aging_read_target = value;
+}
+
+void Configuration::set_aging_worker_placement(const std::string& placement){
+    m_aging_worker_placement = experiment::details::thread_placement_to_string( experiment::details::parse_thread_placement(placement) ); // validate the value
+}
+
+void Configuration::set_insertion_granularity(uint64_t num_edges){
+    if(num_edges < 1){ ERROR("Invalid value for the insertion granularity: " << num_edges << ". Expected a value of at least 1"); }
+    m_insertion_granularity = num_edges;
+}
+
+void Configuration::set_epoch_frequency(uint64_t millisecs){
+    if(millisecs < 1){ ERROR("Invalid value for the frequency of the epochs: " << millisecs << " ms. It must be at least 1 ms"); }
+    m_epoch_frequency = millisecs;
+}
+
+void Configuration::set_gc_budget(uint64_t microsecs){
+    m_gc_budget = microsecs;
+}
+
+void Configuration::set_gc_frequency(uint64_t millisecs){
+    if(millisecs < 1){ ERROR("Invalid value for the frequency of the garbage collector: " << millisecs << " ms. It must be at least 1 ms"); }
+    m_gc_frequency = millisecs;
+}
+
+void Configuration::set_gc_policy(const std::string& policy){
+    m_gc_policy = experiment::details::gc_policy_to_string( experiment::details::parse_gc_policy(policy) ); // validate the value
+}
+
+void Configuration::set_insertion_order(const std::string& order){
+    m_insertion_order = experiment::insertion_order_to_string( experiment::parse_insertion_order(order) ); // validate the value
+}
+
+void Configuration::set_insertion_placement(const std::string& placement){
+    m_insertion_placement = experiment::details::thread_placement_to_string( experiment::details::parse_thread_placement(placement) ); // validate the value
+}
+
+void Configuration::set_insertion_scheduler(const std::string& scheduler){
+    m_insertion_scheduler = experiment::insertion_scheduler_to_string( experiment::parse_insertion_scheduler(scheduler) ); // validate the value
+}
+
+void Configuration::set_insertion_timeline_resolution(uint64_t millisecs){
+    if(millisecs > 0 && millisecs < 100){
+        ERROR("Invalid value for the resolution of the insertion timeline: " << millisecs << " ms. It must be at least 100 ms");
+    }
+    m_insertion_timeline_resolution = millisecs;
+}
+
+void Configuration::set_aging_update_batch_size(uint64_t value){
+    if(value < 1){ ERROR("Invalid value for the update batch size: " << value << ". Expected a value of at least 1"); }
+    m_aging_update_batch_size = value;
+}
+
+void Configuration::set_aging_checkpoint(const std::string& path, uint64_t interval_secs){
+    if(path.empty()){ ERROR("Invalid path for the checkpoint: empty string"); }
+    if(interval_secs == 0){ ERROR("Invalid interval for the checkpoints: 0 seconds"); }
+    m_aging_checkpoint_path = path;
+    m_aging_checkpoint_interval = interval_secs;
+}
+
+void Configuration::set_aging_synthetic(const std::string& pattern){
+    m_aging_synthetic = experiment::details::synthetic_pattern_to_string( experiment::details::parse_synthetic_pattern(pattern) ); // validate the value
+}
+
+void Configuration::set_aging_synthetic_zipf(double alpha){
+    if(alpha <= 0){ ERROR("Invalid value for the exponent of the Zipf distribution: " << alpha << ". Expected a positive value"); }
+    m_aging_synthetic_zipf = alpha;
+}
+
+void Configuration::set_sliding_window(uint64_t window_size, uint64_t num_passes, uint64_t gc_frequency_millisecs){
+    if(window_size == 0){ ERROR("Invalid size for the sliding window: 0 edges"); }
+    if(num_passes == 0){ ERROR("Invalid number of passes for the sliding window: 0"); }
+    m_sliding_window_size = window_size;
+    m_sliding_window_passes = num_passes;
+    m_sliding_window_gc = gc_frequency_millisecs;
+}
+
+void Configuration::set_aging_resume(bool value){
+    if(value && m_aging_checkpoint_path.empty()){ ERROR("Cannot resume the experiment without a checkpoint. Set the path to the checkpoint with --aging_checkpoint"); }
+    m_aging_resume = value;
+}
+
+void Configuration::set_aging_timeline_resolution(uint64_t millisecs){
+    if(millisecs > 0 && millisecs < 100){
+        ERROR("Invalid value for the resolution of the aging timeline: " << millisecs << " ms. It must be at least 100 ms");
+    }
+    m_aging_timeline_resolution = millisecs;
+}
+
 void Configuration::set_aging_cooloff_seconds(uint64_t value){
     m_aging_cooloff_seconds = value;
 }
@@ -471,6 +741,13 @@ bool Configuration::is_load() const {
     return m_load;
 }
 
+void Configuration::set_mixed_progress(double warmup, double stop){
+    if(warmup < 0 || warmup >= 1){ ERROR("Invalid value for the warm-up of the mixed workload: " << warmup << ". Expected a value in [0, 1)"); }
+    if(stop <= warmup || stop > 1){ ERROR("Invalid value for the end of the analytics in the mixed workload: " << stop << ". Expected a value in (" << warmup << ", 1]"); }
+    m_mixed_warmup_progress = warmup;
+    m_mixed_stop_progress = stop;
+}
+
 bool Configuration::is_mixed_workload() const {
     return m_is_mixed_workload;
 }
@@ -540,6 +817,29 @@ void Configuration::save_parameters() {
     params.push_back(P("max_weight", to_string(max_weight())));
     params.push_back(P{"seed", to_string(seed())});
     params.push_back(P{"aging", to_string(m_coeff_aging)});
+    if(get_aging_arrival_rate() > 0){
+        params.push_back(P{"aging_arrival", get_aging_arrival_process()});
+        params.push_back(P{"aging_rate", to_string(get_aging_arrival_rate())});
+    }
+    params.push_back(P{"aging_granularity", to_string(get_aging_granularity_target())}); // microseconds
+    params.push_back(P{"aging_placement", get_aging_worker_placement()});
+    if(get_aging_read_ratio() > 0){
+        params.push_back(P{"aging_read_ratio", to_string(get_aging_read_ratio())});
+        params.push_back(P{"aging_read_target", get_aging_read_target()});
+    }
+    params.push_back(P{"update_batch_size", to_string(get_aging_update_batch_size())});
+    if(!get_aging_checkpoint_path().empty()){
+        params.push_back(P{"aging_checkpoint", get_aging_checkpoint_path()});
+        params.push_back(P{"aging_checkpoint_interval", to_string(get_aging_checkpoint_interval())}); // seconds
+        params.push_back(P{"aging_resume", to_string(get_aging_resume())});
+    }
+    if(get_aging_streaming() > 0){ params.push_back(P{"aging_streaming", to_string(get_aging_streaming())}); }
+    if(!get_aging_synthetic().empty()){
+        params.push_back(P{"aging_synthetic", get_aging_synthetic()});
+        params.push_back(P{"aging_synthetic_zipf", to_string(get_aging_synthetic_zipf())});
+        params.push_back(P{"aging_synthetic_window", to_string(get_aging_synthetic_window())});
+        params.push_back(P{"aging_synthetic_burst", to_string(get_aging_synthetic_burst())});
+    }
     params.push_back(P{"aging_cooloff", to_string(get_aging_cooloff_seconds())});
     params.push_back(P{"aging_memfp", to_string(get_aging_memfp())});
     params.push_back(P{"aging_memfp_physical", to_string(get_aging_memfp_physical())});
@@ -547,12 +847,28 @@ void Configuration::save_parameters() {
     params.push_back(P{"aging_memfp_threshold", to_string(get_aging_memfp_threshold())});
     params.push_back(P{"aging_release_memory", to_string(get_aging_release_memory())});
     params.push_back(P{"aging_step_size", to_string(get_aging_step_size())});
+    params.push_back(P{"aging_timeline", to_string(get_aging_timeline_resolution())}); // milliseconds
     params.push_back(P{"aging_timeout", to_string(get_timeout_aging2())});
+    params.push_back(P{"analytic_clients", to_string(get_analytic_clients())});
     params.push_back(P{"build_frequency", to_string(get_build_frequency())}); // milliseconds
+    if(is_bulk_load()){ params.push_back(P{"bulk_load", "true"}); }
+    if(is_calibration()){ params.push_back(P{"calibrate", "true"}); }
     params.push_back(P{"ef_edges", to_string(get_ef_edges())});
     params.push_back(P{"ef_vertices", to_string(get_ef_vertices())});
+    params.push_back(P{"epoch_frequency", to_string(get_epoch_frequency())}); // milliseconds
+    params.push_back(P{"gc_budget", to_string(get_gc_budget())}); // microseconds
+    params.push_back(P{"gc_frequency", to_string(get_gc_frequency())}); // milliseconds
+    params.push_back(P{"gc_graphalytics", to_string(is_gc_graphalytics())});
+    params.push_back(P{"gc_policy", get_gc_policy()});
     if(!get_path_graph().empty()){ params.push_back(P{"graph", get_path_graph()}); }
+    params.push_back(P{"hardware_counters", to_string(measure_hardware_counters())});
+    params.push_back(P{"insertion_granularity", to_string(get_insertion_granularity())});
+    params.push_back(P{"insertion_order", get_insertion_order()});
+    params.push_back(P{"insertion_placement", get_insertion_placement()});
+    params.push_back(P{"insertion_scheduler", get_insertion_scheduler()});
+    params.push_back(P{"insertion_timeline", to_string(get_insertion_timeline_resolution())}); // milliseconds
     params.push_back(P{"measure_latency", to_string(measure_latency())});
+    if(measure_latency() && get_latency_sampling() > 1){ params.push_back(P{"latency_sampling", to_string(get_latency_sampling())}); }
     params.push_back(P{"num_repetitions", to_string(num_repetitions())});
     params.push_back(P{"num_threads_omp", to_string(num_threads_omp())});
     params.push_back(P{"num_threads_read", to_string(num_threads(ThreadsType::THREADS_READ))});
@@ -569,12 +885,24 @@ void Configuration::save_parameters() {
         params.push_back(P{"aging_impl", "version_3"});
         params.push_back(P{"log", get_update_log()});
     }
+    if(get_sliding_window_size() > 0){
+        params.push_back(P{"sliding_window", to_string(get_sliding_window_size())});
+        params.push_back(P{"sliding_window_gc", to_string(get_sliding_window_gc())}); // milliseconds
+        params.push_back(P{"sliding_window_passes", to_string(get_sliding_window_passes())});
+    }
     params.push_back(P{"role", "standalone"});
     params.push_back(P{"validate_inserts", to_string(validate_inserts())});
     params.push_back(P{"validate_output", to_string(validate_output())});
     params.push_back(P{"validate_output_graph", get_validation_graph()});
     params.push_back(P{"block_size", to_string(block_size())});
     params.push_back(P{"is_mixed_workload", to_string(m_is_mixed_workload)});
+    if(is_mixed_workload()){
+        params.push_back(P{"mixed_duration", to_string(get_mixed_duration())}); // milliseconds
+        params.push_back(P{"mixed_iterations", to_string(get_mixed_iterations())});
+        params.push_back(P{"mixed_stop", to_string(get_mixed_stop_progress())});
+        params.push_back(P{"mixed_warmup", to_string(get_mixed_warmup_progress())});
+        params.push_back(P{"mixed_warmup_ops", to_string(get_mixed_warmup_operations())});
+    }
 
     if(!m_blacklist.empty()){
         stringstream ss;
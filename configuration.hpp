@@ -60,29 +60,68 @@ class Configuration {
 
     // properties
     uint64_t m_aging_cooloff_seconds { 0 }; // cool-off period in the aging experiment, in seconds.
+    uint64_t m_aging_granularity_target { 1000 }; // in the aging2 experiment, adapt the granularity of the workers so that each chunk of updates takes the given time, in microseconds (0 = fixed granularity)
     bool m_aging_memfp = false; // whether to measure the memory footprint
     bool m_aging_memfp_physical = false; // whether to compute the physical memory or the virtual memory
     bool m_aging_memfp_report = false; // whether to print stdout the measurements observed for the memory footprint
     uint64_t m_aging_memfp_threshold { 0 }; // forcedly stop the execution of the aging2 experiment if the process is using more memory than this threshold, in bytes
     bool m_aging_release_memory = true; // whether to release the memory from the driver as the experiment proceeds
+    double m_aging_arrival_rate { 0 }; // in the aging2 experiment, open-loop mode, the target number of updates per second issued by each worker (0 = closed loop)
+    std::string m_aging_arrival_process { "constant" }; // in the aging2 experiment, open-loop mode, the distribution of the inter-arrival times: constant or poisson
+    double m_aging_read_ratio { 0 }; // in the aging2 experiment, the fraction of operations that are point lookups rather than updates
+    std::string m_aging_read_target { "recent" }; // in the aging2 experiment, the edges targeted by the point lookups: recent or random
+    std::string m_aging_worker_placement { "default" }; // in the aging2 experiment, how to pin the workers to the logical CPUs: default, none, compact or round_robin
+    uint64_t m_aging_update_batch_size { 1 }; // in the aging2 experiment, the number of updates sent by a worker in a single invocation to #update_batch
+    std::string m_aging_checkpoint_path; // in the aging2 experiment, where to periodically save the progress of the experiment (empty = disabled)
+    uint64_t m_aging_checkpoint_interval { 1800 }; // in the aging2 experiment, how often to save the progress of the experiment, in seconds
+    bool m_aging_resume = false; // in the aging2 experiment, whether to resume the experiment from the last checkpoint
+    uint64_t m_aging_streaming { 0 }; // in the aging2 experiment, decode the log while the experiment runs, with at most the given number of blocks queued per worker (0 = load all updates upfront)
+    std::string m_aging_synthetic; // in the aging2 experiment, generate the updates in the driver with the given pattern: uniform, zipf, window or burst (empty = use the log file)
+    double m_aging_synthetic_zipf { 1.0 }; // in the aging2 experiment, the exponent of the Zipf distribution for the synthetic pattern zipf
+    uint64_t m_aging_synthetic_window { 0 }; // in the aging2 experiment, the number of operations a synthetic temporary edge stays in the graph (0 = the number of edges in the graph)
+    uint64_t m_aging_synthetic_burst { 0 }; // in the aging2 experiment, the length of a period, in number of operations, for the synthetic pattern burst (0 = 1/10 of the operations)
+    uint64_t m_aging_timeline_resolution { 0 }; // in the aging2 experiment, the length of each window of the timeline for the throughput & latency, in milliseconds (0 = disabled)
+    uint64_t m_analytic_clients { 1 }; // in the mixed workload, the number of analytic clients running the Graphalytics suite concurrently
     std::vector<std::string> m_blacklist; // list of graph algorithms that cannot be executed
+    bool m_bulk_load = false; // whether to populate the library with #bulk_load, rather than with the InsertOnly experiment
     uint64_t m_build_frequency { 0 }; // in the aging experiment, the amount of time that must pass before each invocation to #build(), in milliseconds
+    bool m_calibrate = false; // whether to measure the overhead of the driver with the library dummy_v3, rather than running an experiment
     double m_coeff_aging { 0.0 }; // coefficient for the additional updates to perform
     common::Database* m_database { nullptr }; // handle to the database
     std::string m_database_path { "" }; // the path where to store the results
     double m_ef_vertices = 1; // expansion factor for the vertices in the graph
     double m_ef_edges = 1;  // expansion factor for the edges in the graph
+    uint64_t m_epoch_frequency { 5000 }; // in the mixed workload, how frequently to create a new epoch in the library, in milliseconds
+    uint64_t m_gc_budget { 0 }; // in the mixed workload, the max time for each invocation to the garbage collector, in microseconds (0 = unbounded)
+    uint64_t m_gc_frequency { 500 }; // in the mixed workload, how frequently to invoke the garbage collector of the library, in milliseconds
+    bool m_gc_graphalytics = true; // whether to invoke the garbage collector of the library once before running the Graphalytics suite
+    std::string m_gc_policy { "periodic" }; // in the mixed workload, when to invoke the garbage collector: none, periodic or after_epoch
     bool m_graph_directed = true; // whether the graph is undirected or directed
+    bool m_hardware_counters = false; // whether to record the hardware counters (libpapi) for each phase of the experiments and each graphalytics kernel
+    uint64_t m_insertion_granularity { 1ull << 20 }; // in the insert only experiment, the number of edges in each chunk handed to a worker by the scheduler
+    std::string m_insertion_order { "random" }; // in the insert only experiment, the order to insert the edges: random, sorted_chunks or vertex_partitioned
+    std::string m_insertion_placement { "none" }; // in the insert only experiment, how to pin the workers to the logical CPUs: default, none, compact or round_robin
+    std::string m_insertion_scheduler { "dynamic" }; // in the insert only experiment, how to distribute the edges among the workers: static, dynamic or guided
+    uint64_t m_insertion_timeline_resolution { 0 }; // in the insert only experiment, the length of each window of the timeline for the throughput & memory footprint, in milliseconds (0 = disabled)
     std::string m_library_name; // the library to test
+    uint64_t m_mixed_duration { 0 }; // in the mixed workload, stop the analytics after the given amount of time, in milliseconds (0 = no limit)
+    uint64_t m_mixed_iterations { 0 }; // in the mixed workload, stop each analytic client after the given number of executions of the suite (0 = no limit)
+    double m_mixed_stop_progress { 0.9 }; // in the mixed workload, stop the analytics once the writers performed this fraction of the updates
+    uint64_t m_mixed_warmup_operations { 0 }; // in the mixed workload, start the analytics once the writers performed this number of updates
+    double m_mixed_warmup_progress { 0.1 }; // in the mixed workload, start the analytics once the writers performed this fraction of the updates
     bool m_load = false; // whether to load the graph in one go
     double m_max_weight { 1.0 }; // the maximum weight that can be assigned when reading non weighted graphs
     bool m_measure_latency = false; // whether to measure the latency of the update operations (insert/deletion).
+    uint64_t m_latency_sampling { 1 }; // in the insert only experiment, measure the latency of one insertion every `m_latency_sampling' insertions
     uint64_t m_num_repetitions { 0 }; // when applicable, how many times the same experiment should be repeated
     int m_num_threads_omp { 0 }; // if different than 0, the max number of threads used by OpenMP
     int m_num_threads_read { 0 }; // number of threads to use for the read operations. The value of 0 is the default of OpenMP.
     int m_num_threads_write { 1 }; // number of threads to use for the write (insert/update/delete) operations
     std::string m_path_graph_to_load; // the file must be accessible to the server
     uint64_t m_seed = 5051789ull; // random seed, used in various places in the experiments
+    uint64_t m_sliding_window_size { 0 }; // in the sliding window experiment, the number of edges retained in the window (0 = experiment disabled)
+    uint64_t m_sliding_window_passes { 1 }; // in the sliding window experiment, how many times to replay the stream of edges
+    uint64_t m_sliding_window_gc { 0 }; // in the sliding window experiment, how often to invoke the garbage collector of the library, in milliseconds (0 = never)
     double m_step_size_recordings { 1.0 }; // in the aging2 experiment, how often to record the progress done in the db. It must be a value in (0, 1].
     uint64_t m_timeout_aging2 { 0 }; // forcedly stop the aging2 experiment after the given amount of seconds
     uint64_t m_timeout_graphalytics { 3600 }; // max time to complete a kernel from Graphalytics, in seconds (0 => indefinite)
@@ -96,8 +135,21 @@ class Configuration {
     bool m_is_timestamped_graph = false;
 
     void set_aging_cooloff_seconds(uint64_t value);
+    void set_aging_granularity_target(uint64_t microsecs); // The target time for each chunk of updates of an Aging2 worker (0 = fixed granularity)
     void set_aging_memfp_threshold(uint64_t bytes);
     void set_aging_step_size(double value); // The step in each recording in the progress for the Agin2 experiment. In (0, 1].
+    void set_aging_arrival_rate(double ops_per_sec); // Open-loop mode for the Aging2 experiment, target updates/sec per worker
+    void set_aging_arrival_process(const std::string& process); // Open-loop mode for the Aging2 experiment, either "constant" or "poisson"
+    void set_aging_read_ratio(double ratio); // The fraction of operations that are point lookups in the Aging2 experiment, in [0, 1)
+    void set_aging_read_target(const std::string& target); // The edges targeted by the point lookups in the Aging2 experiment: recent or random
+    void set_aging_worker_placement(const std::string& placement); // How to pin the Aging2 workers: default, none, compact or round_robin
+    void set_aging_update_batch_size(uint64_t value); // The number of updates sent by each Aging2 worker in a single batch, at least 1
+    void set_aging_checkpoint(const std::string& path, uint64_t interval_secs); // Periodically save the progress of the Aging2 experiment in the given file
+    void set_aging_resume(bool value); // Resume the Aging2 experiment from the last checkpoint
+    void set_aging_synthetic(const std::string& pattern); // Generate the updates of the Aging2 experiment in the driver: uniform, zipf, window or burst
+    void set_aging_synthetic_zipf(double alpha); // The exponent of the Zipf distribution for the synthetic pattern zipf, > 0
+    void set_aging_timeline_resolution(uint64_t millisecs); // The length of each window in the timeline of the Aging2 experiment, at least 100 ms
+    void set_analytic_clients(uint64_t num_clients); // The number of concurrent analytic clients in the mixed workload, at least 1
     void set_build_frequency(uint64_t millisecs);
     void set_coeff_aging(double value); // Set the coefficient for `aging', i.e. how many updates (insertions/deletions) to perform w.r.t. to the size of the loaded graph
     void set_ef_vertices(double value);
@@ -109,7 +161,17 @@ class Configuration {
     void set_num_threads_write(int value); // Set the number of threads to use in the write operations.
     void set_timeout_aging2(uint64_t seconds); // Set the maximum amount of time (excl. cool-off time) to run the Aging2 experiment
     void set_timeout_graphalytics(uint64_t seconds); // Set the timeout property
+    void set_epoch_frequency(uint64_t millisecs); // How frequently to create a new epoch in the mixed workload, at least 1 ms
+    void set_gc_budget(uint64_t microsecs); // The max time for each invocation to the garbage collector in the mixed workload (0 = unbounded)
+    void set_gc_frequency(uint64_t millisecs); // How frequently to invoke the garbage collector in the mixed workload, at least 1 ms
+    void set_gc_policy(const std::string& policy); // When to invoke the garbage collector in the mixed workload: none, periodic or after_epoch
     void set_graph(const std::string& graph); // Set the graph to load and run the experiments
+    void set_insertion_granularity(uint64_t num_edges); // The number of edges in each chunk handed to a worker of the InsertOnly experiment, at least 1
+    void set_insertion_order(const std::string& order); // The order to insert the edges in the InsertOnly experiment: random, sorted_chunks or vertex_partitioned
+    void set_insertion_placement(const std::string& placement); // How to pin the workers of the InsertOnly experiment: default, none, compact or round_robin
+    void set_insertion_scheduler(const std::string& scheduler); // How to distribute the edges among the workers of the InsertOnly experiment: static, dynamic or guided
+    void set_insertion_timeline_resolution(uint64_t millisecs); // The length of each window in the timeline of the InsertOnly experiment, at least 100 ms
+    void set_mixed_progress(double warmup, double stop); // The fraction of updates that start and stop the analytics in the mixed workload, 0 <= warmup < stop <= 1
     void set_block_size(size_t block_size);
     void set_is_timestamped(bool timestamped);
 
@@ -122,6 +184,10 @@ class Configuration {
     // Set the property seed
     void set_seed(uint64_t value){ m_seed = value; }
 
+    // Set the properties of the sliding window experiment: the number of edges in the window, the number of passes over
+    // the stream and how often to invoke the garbage collector, in milliseconds
+    void set_sliding_window(uint64_t window_size, uint64_t num_passes, uint64_t gc_frequency_millisecs);
+
     // Check whether the given property has been blacklisted
     void do_blacklist(bool& property_enabled, const char* property_name) const;
 public:
@@ -167,6 +233,57 @@ public:
     // Measure the latency of update operations ?
     bool measure_latency() const { return m_measure_latency; }
 
+    // The number of edges in each chunk handed to a worker by the scheduler of the insert only experiment
+    uint64_t get_insertion_granularity() const { return m_insertion_granularity; }
+
+    // The order to insert the edges in the insert only experiment: random, sorted_chunks or vertex_partitioned
+    const std::string& get_insertion_order() const { return m_insertion_order; }
+
+    // How frequently to create a new epoch in the mixed workload, in milliseconds
+    uint64_t get_epoch_frequency() const { return m_epoch_frequency; }
+
+    // The max amount of time for each invocation to the garbage collector in the mixed workload, in microseconds (0 = unbounded)
+    uint64_t get_gc_budget() const { return m_gc_budget; }
+
+    // How frequently to invoke the garbage collector in the mixed workload, with the policy periodic, in milliseconds
+    uint64_t get_gc_frequency() const { return m_gc_frequency; }
+
+    // Whether to invoke the garbage collector of the library once before running the Graphalytics suite
+    bool is_gc_graphalytics() const { return m_gc_graphalytics; }
+
+    // When to invoke the garbage collector in the mixed workload: none, periodic or after_epoch
+    const std::string& get_gc_policy() const { return m_gc_policy; }
+
+    // How to pin the workers of the insert only experiment: default, none, compact or round_robin
+    const std::string& get_insertion_placement() const { return m_insertion_placement; }
+
+    // How to distribute the edges among the workers of the insert only experiment: static, dynamic or guided
+    const std::string& get_insertion_scheduler() const { return m_insertion_scheduler; }
+
+    // The length of each window in the timeline of the insert only experiment, in milliseconds (0 = disabled)
+    uint64_t get_insertion_timeline_resolution() const { return m_insertion_timeline_resolution; }
+
+    // In the mixed workload, stop the analytics after the given amount of time, in milliseconds (0 = no limit)
+    uint64_t get_mixed_duration() const { return m_mixed_duration; }
+
+    // In the mixed workload, stop each analytic client after the given number of executions of the Graphalytics suite (0 = no limit)
+    uint64_t get_mixed_iterations() const { return m_mixed_iterations; }
+
+    // In the mixed workload, stop the analytics once the writers performed this fraction of all updates
+    double get_mixed_stop_progress() const { return m_mixed_stop_progress; }
+
+    // In the mixed workload, start the analytics once the writers performed at least this number of updates
+    uint64_t get_mixed_warmup_operations() const { return m_mixed_warmup_operations; }
+
+    // In the mixed workload, start the analytics once the writers performed at least this fraction of all updates
+    double get_mixed_warmup_progress() const { return m_mixed_warmup_progress; }
+
+    // Measure the latency of one insertion every N insertions, in the insert only experiment
+    uint64_t get_latency_sampling() const { return m_latency_sampling; }
+
+    // Record the hardware counters for each phase of the experiments and each graphalytics kernel ?
+    bool measure_hardware_counters() const { return m_hardware_counters; }
+
     // Number of repetitions of the same experiment (when applicable)
     uint64_t num_repetitions() const { return m_num_repetitions; }
 
@@ -191,9 +308,15 @@ public:
     // Get the expansion factor in the aging experiment for the vertices in the graph
     double get_ef_vertices() const { return m_ef_vertices; }
 
+    // The number of analytic clients running the Graphalytics suite concurrently in the mixed workload
+    uint64_t get_analytic_clients() const { return m_analytic_clients; }
+
     // Get the frequency to build a new snapshot, in milliseconds
     uint64_t get_build_frequency() const{ return m_build_frequency; }
 
+    // Whether to measure the overhead of the driver with the library dummy_v3, rather than running an experiment
+    bool is_calibration() const { return m_calibrate; }
+
     // Get the cool-off period in the aging experiment. After the experiment terminates, the driver waits for the given
     // amount of seconds idle, checking the amount of memory used. The goal is to detect the impact of the garbage
     // collector of the evaluated library in reducing the memory footprint when no updates are being executed.
@@ -215,12 +338,63 @@ public:
     // Whether to release the memory from the driver as the experiment proceeds
     bool get_aging_release_memory() const { return m_aging_release_memory; }
 
+    // The target time for each chunk of updates of a worker in the aging2 experiment, in microseconds (0 = fixed granularity)
+    uint64_t get_aging_granularity_target() const { return m_aging_granularity_target; }
+
+    // Whether to decode the log while the aging2 experiment runs, the max number of blocks queued per worker (0 = load all updates upfront)
+    uint64_t get_aging_streaming() const { return m_aging_streaming; }
+
+    // Open-loop mode in the aging2 experiment, the target number of updates per second issued by each worker (0 = closed loop)
+    double get_aging_arrival_rate() const { return m_aging_arrival_rate; }
+
+    // Open-loop mode in the aging2 experiment, the distribution of the inter-arrival times: either "constant" or "poisson"
+    const std::string& get_aging_arrival_process() const { return m_aging_arrival_process; }
+
+    // The fraction of operations that are point lookups, rather than updates, in the aging2 experiment
+    double get_aging_read_ratio() const { return m_aging_read_ratio; }
+
+    // The edges targeted by the point lookups in the aging2 experiment: either "recent" or "random"
+    const std::string& get_aging_read_target() const { return m_aging_read_target; }
+
+    // How to pin the workers of the aging2 experiment to the logical CPUs: default, none, compact or round_robin
+    const std::string& get_aging_worker_placement() const { return m_aging_worker_placement; }
+
+    // The number of updates sent by a worker of the aging2 experiment in a single invocation to #update_batch (1 = one update at the time)
+    uint64_t get_aging_update_batch_size() const { return m_aging_update_batch_size; }
+
+    // Where to periodically save the progress of the aging2 experiment (empty = disabled)
+    const std::string& get_aging_checkpoint_path() const { return m_aging_checkpoint_path; }
+
+    // How often to save the progress of the aging2 experiment, in seconds
+    uint64_t get_aging_checkpoint_interval() const { return m_aging_checkpoint_interval; }
+
+    // Whether to resume the aging2 experiment from the last checkpoint
+    bool get_aging_resume() const { return m_aging_resume; }
+
+    // The pattern to generate the updates of the aging2 experiment in the driver: uniform, zipf, window or burst (empty = use the log file)
+    const std::string& get_aging_synthetic() const { return m_aging_synthetic; }
+
+    // The exponent of the Zipf distribution for the synthetic pattern zipf
+    double get_aging_synthetic_zipf() const { return m_aging_synthetic_zipf; }
+
+    // The number of operations a synthetic temporary edge stays in the graph (0 = the number of edges in the graph)
+    uint64_t get_aging_synthetic_window() const { return m_aging_synthetic_window; }
+
+    // The length of a period, in number of operations, for the synthetic pattern burst (0 = 1/10 of the operations)
+    uint64_t get_aging_synthetic_burst() const { return m_aging_synthetic_burst; }
+
+    // The length of each window in the timeline of the throughput & latency for the aging2 experiment, in milliseconds (0 = disabled)
+    uint64_t get_aging_timeline_resolution() const { return m_aging_timeline_resolution; }
+
     // Check whether the configuration/results need to be stored into a database
     bool has_database() const;
 
     // Whether to load the graph in one go
     bool is_load() const;
 
+    // Whether to populate the library with the method #bulk_load, rather than executing the InsertOnly experiment
+    bool is_bulk_load() const { return m_bulk_load; }
+
     // Retrieve the handle to the database connection, where the final results of the experiments are stored
     ::common::Database* db();
 
@@ -230,6 +404,15 @@ public:
     // Random seed, used in various places in the experiments
     uint64_t seed() const { return m_seed; };
 
+    // The number of edges retained in the window of the sliding window experiment (0 = experiment disabled)
+    uint64_t get_sliding_window_size() const { return m_sliding_window_size; }
+
+    // How many times to replay the stream of edges in the sliding window experiment
+    uint64_t get_sliding_window_passes() const { return m_sliding_window_passes; }
+
+    // How often to invoke the garbage collector of the library in the sliding window experiment, in milliseconds (0 = never)
+    uint64_t get_sliding_window_gc() const { return m_sliding_window_gc; }
+
     // Get the max weight that can be assigned by the reader to
     double max_weight() const { return m_max_weight; }
 
@@ -17,7 +17,11 @@
 
 #include "aging2_experiment.hpp"
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <mutex>
 #include <thread>
 
@@ -69,6 +73,10 @@ void Aging2Experiment::set_log(const std::string& path){
     m_path_log = path;
 }
 
+void Aging2Experiment::set_synthetic_log(std::shared_ptr<details::SyntheticLog> synthetic_log){
+    m_synthetic_log = synthetic_log;
+}
+
 void Aging2Experiment::set_max_weight(double value){
     if(value <= 0){ INVALID_ARGUMENT("value <= 0: " << value); }
     m_max_weight = value;
@@ -79,6 +87,17 @@ void Aging2Experiment::set_parallelism_degree(uint64_t num_threads){
     m_num_threads = num_threads;
 }
 
+void Aging2Experiment::set_num_reader_threads(uint64_t num_threads){
+    if(num_threads < 1){ INVALID_ARGUMENT("num_threads < 1: " << num_threads); }
+    m_num_reader_threads = num_threads;
+}
+
+int Aging2Experiment::reader_thread_id(uint64_t reader) const {
+    assert(reader < m_num_reader_threads && "Invalid reader");
+    // 0 is not used by the workers, 1 ... m_num_threads are the workers, followed by the master and the builder service
+    return reader == 0 ? 0 : static_cast<int>(m_num_threads + 2 + reader);
+}
+
 void Aging2Experiment::set_build_frequency(std::chrono::milliseconds millisecs){
     m_build_frequency = millisecs;
 }
@@ -113,10 +132,61 @@ void Aging2Experiment::set_worker_granularity(uint64_t value){
     m_worker_granularity = value;
 }
 
+void Aging2Experiment::set_worker_granularity_target(std::chrono::microseconds target){
+    if(target < 0us){ INVALID_ARGUMENT("The target time for a chunk of updates cannot be negative: " << target.count() << " microsecs"); }
+    m_worker_granularity_target = target;
+}
+
 void Aging2Experiment::set_cooloff(std::chrono::seconds secs){
     m_cooloff = secs;
 }
 
+void Aging2Experiment::set_checkpoint(const std::string& path, std::chrono::seconds interval){
+    if(!path.empty() && interval <= 0s){ INVALID_ARGUMENT("The interval between two checkpoints must be positive: " << interval.count() << " seconds"); }
+    m_checkpoint_path = path;
+    m_checkpoint_interval = interval;
+}
+
+void Aging2Experiment::set_resume(bool value){
+    m_resume = value;
+}
+
+void Aging2Experiment::set_worker_placement(ThreadPlacement placement){
+    m_worker_placement = placement;
+}
+
+void Aging2Experiment::set_read_ratio(double ratio){
+    if(ratio < 0 || ratio >= 1){ INVALID_ARGUMENT("The read ratio must be in [0, 1): " << ratio); }
+    m_read_ratio = ratio;
+}
+
+void Aging2Experiment::set_read_target(ReadTarget target){
+    m_read_target = target;
+}
+
+void Aging2Experiment::set_update_batch_size(uint64_t value){
+    if(value < 1){ INVALID_ARGUMENT("The batch size must be at least 1: " << value); }
+    m_update_batch_size = value;
+}
+
+void Aging2Experiment::set_arrival_rate(double ops_per_sec){
+    if(ops_per_sec < 0){ INVALID_ARGUMENT("The arrival rate must be non negative: " << ops_per_sec); }
+    m_arrival_rate = ops_per_sec;
+}
+
+void Aging2Experiment::set_arrival_process(ArrivalProcess process){
+    m_arrival_process = process;
+}
+
+void Aging2Experiment::set_timeline_resolution(std::chrono::milliseconds millisecs){
+    if(millisecs > 0ms && millisecs < 100ms){ INVALID_ARGUMENT("The resolution of the timeline must be at least 100 ms, given: " << millisecs.count() << " ms"); }
+    m_timeline_resolution = millisecs;
+}
+
+void Aging2Experiment::set_streaming(uint64_t depth){
+    m_streaming_depth = depth;
+}
+
 void Aging2Experiment::set_memfp(bool value){
     m_memfp = value;
 }
@@ -131,23 +201,90 @@ void Aging2Experiment::set_memfp_threshold(uint64_t value) {
 
 Aging2Result Aging2Experiment::execute(){
     if(m_library.get() == nullptr) ERROR("Library not set. Use #set_library to set it.");
-    if(m_path_log.empty()) ERROR("Path to the log file not set. Use #set_log to set it.")
+    if(m_path_log.empty() && m_synthetic_log.get() == nullptr) ERROR("Path to the log file not set. Use #set_log or #set_synthetic_log to set it.")
+    if(!m_path_log.empty() && m_synthetic_log.get() != nullptr) ERROR("Cannot set both a log file and a synthetic log");
+    if(m_resume && m_synthetic_log.get() != nullptr) ERROR("Cannot resume the experiment from a checkpoint with a synthetic log");
+    if(m_resume && m_checkpoint_path.empty()) ERROR("Cannot resume the experiment, the path to the checkpoint is not set. Use #set_checkpoint to set it.");
+    if(m_resume && m_measure_latency) ERROR("Cannot resume the experiment while measuring the latency of the updates, the latencies of the updates performed before the checkpoint are not saved");
+    if(m_streaming_depth > 0 && m_measure_latency) ERROR("Cannot measure the latency of the updates in streaming mode, the number of updates of each worker is not known in advance");
+    if(m_streaming_depth > 0 && m_resume) ERROR("Cannot resume the experiment from a checkpoint in streaming mode");
+    if(m_streaming_depth > 0 && !m_checkpoint_path.empty()) ERROR("Cannot take checkpoints of the experiment in streaming mode, they could not be resumed");
 
-    m_master = new details::Aging2Master(*this);
-    auto result = m_master->execute();
+    details::Aging2Master* master = new details::Aging2Master(*this);
+    unique_lock<mutex> lock(m_progress_mutex);
+    m_master = master;
+    m_progress_done = false;
+    m_num_operations_final = 0;
+    m_progress_final = 0;
+    lock.unlock();
 
-    // Master should be deleted here to ensure the same thread that called the constructor it also calls the destructor
-    // So, the on_thread_init matches the on_thread_destroy.
-    delete m_master;
-    m_master = nullptr;
-    return result;
+    auto terminate = [&](){ // wake up the threads waiting for the progress of the experiment
+        lock.lock();
+        m_num_operations_final = m_master->num_operations_sofar(); // still returned by #num_operations_sofar
+        m_progress_final = m_master->progress_so_far();
+        m_master = nullptr;
+        m_progress_done = true;
+        lock.unlock();
+        m_progress_condvar.notify_all();
+    };
+
+    try {
+        auto result = master->execute();
+        terminate();
+
+        // Master should be deleted here to ensure the same thread that called the constructor it also calls the destructor
+        // So, the on_thread_init matches the on_thread_destroy.
+        delete master;
+        return result;
+    } catch (...) {
+        terminate();
+        delete master;
+        throw;
+    }
 }
 
 double Aging2Experiment::progress_so_far() {
+  scoped_lock<mutex> lock(m_progress_mutex);
   if (m_master == nullptr) {
-    return 0.0;
+    return m_progress_final; // 0 if the experiment has not started yet
   } else {
     return m_master->progress_so_far();
   }
 }
+
+void Aging2Experiment::notify_progress(){
+    unique_lock<mutex> lock(m_progress_mutex);
+    m_progress_target = numeric_limits<uint64_t>::max(); // reset by the waiting threads
+    lock.unlock();
+    m_progress_condvar.notify_all();
+}
+
+bool Aging2Experiment::wait_for_progress(uint64_t num_operations, double progress){
+    unique_lock<mutex> lock(m_progress_mutex);
+    while(!m_progress_done){
+        uint64_t target = 1; // the master is not running yet, wake up on the first operations performed
+        uint64_t num_operations_done = 0;
+        if(m_master != nullptr && m_master->m_experiment_running){
+            target = max<uint64_t>(num_operations, ceil(progress * m_master->num_operations_total()));
+            num_operations_done = m_master->num_operations_sofar();
+            if(num_operations_done >= target) return true;
+        }
+
+        // request the workers to wake us up once they reach the target
+        uint64_t current = m_progress_target.load();
+        while(target < current && !m_progress_target.compare_exchange_weak(current, target)){ /* retry */ }
+        m_progress_condvar.wait(lock);
+    }
+
+    return false; // the experiment terminated
+}
+
+uint64_t Aging2Experiment::num_operations_sofar() {
+  scoped_lock<mutex> lock(m_progress_mutex);
+  if (m_master == nullptr) {
+    return m_num_operations_final; // 0 if the experiment has not started yet
+  } else {
+    return m_master->num_operations_sofar();
+  }
+}
 } // namespace
@@ -17,13 +17,20 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "aging2_result.hpp"
 #include "details/aging2_master.hpp"
+#include "details/event_log.hpp"
+#include "details/synthetic_log.hpp"
+#include "details/thread_placement.hpp"
 
 // forward declarations
 namespace gfe::graph { class WeightedEdgeStream; }
@@ -34,6 +41,22 @@ namespace gfe::library { class UpdateInterface; }
 
 namespace gfe::experiment {
 
+/**
+ * How the updates are issued by each worker in the open-loop mode of the Aging experiment
+ */
+enum class ArrivalProcess {
+    CONSTANT, // fixed inter-arrival time
+    POISSON // exponentially distributed inter-arrival times
+};
+
+/**
+ * Which edges are looked up by the point reads interleaved with the updates in the Aging experiment
+ */
+enum class ReadTarget {
+    RECENT, // the edges recently inserted or removed by the same worker
+    RANDOM // random edges from the sequence of updates of the worker
+};
+
 /**
  * Builder/factory class to create & execute instances of the Aging experiment.
  *
@@ -45,8 +68,12 @@ class Aging2Experiment {
     friend class details::Aging2Worker;
 
     std::string m_path_log; // the path to the log file [graphlog] with the sequence of updates to perform
+    std::shared_ptr<details::SyntheticLog> m_synthetic_log; // generate the sequence of updates in the driver, rather than reading it from a graphlog
+    uint64_t m_streaming_depth = 0; // streaming mode, the max number of decoded blocks queued for each worker (0 = load all updates before starting)
     uint64_t m_num_threads = 1; // set the number of threads to use
+    uint64_t m_num_reader_threads = 1; // the number of threads that can run the analytics concurrently to the updates, each with its own thread_id
     uint64_t m_worker_granularity = 1024; // the granularity of a task for a worker, that is the number of contiguous operations (inserts/deletes) performed inside the threads between each invocation to the scheduler.
+    std::chrono::microseconds m_worker_granularity_target {0}; // adapt the granularity of the workers at runtime, so that each chunk of operations takes about the given wall time (0 = fixed granularity)
     double m_max_weight = 1.0; // set the max weight for the edges to create
     std::chrono::milliseconds m_build_frequency {0}; // the frequency to create a new delta/snapshot, that is invoking the method #build()
     bool m_memfp = false; // whether to measure the memory footprint
@@ -59,8 +86,37 @@ class Aging2Experiment {
     bool m_measure_latency = false; // whether to measure the latency of updates
     std::chrono::seconds m_timeout {0}; // max time to run the simulation (excl. cool-off time)
     std::chrono::seconds m_cooloff {0}; // number of seconds to wait after the experiment terminates, to check the effectiveness of the GC
+    ThreadPlacement m_worker_placement = ThreadPlacement::DEFAULT; // how to pin the worker threads to the logical CPUs
+    double m_read_ratio = 0; // the fraction of operations that are point lookups, rather than updates, in [0, 1)
+    ReadTarget m_read_target = ReadTarget::RECENT; // which edges are looked up by the point reads
+    uint64_t m_update_batch_size = 1; // the number of updates sent by a worker in a single invocation to #update_batch (1 = one update at the time)
+    double m_arrival_rate = 0; // open-loop mode, the target number of updates per second issued by each worker (0 = closed loop)
+    ArrivalProcess m_arrival_process = ArrivalProcess::CONSTANT; // open-loop mode, the distribution of the inter-arrival times
+    std::string m_checkpoint_path; // where to periodically save the progress of the experiment (empty = disabled)
+    std::chrono::seconds m_checkpoint_interval {0}; // how often to save the progress of the experiment
+    bool m_resume = false; // whether to resume the experiment from the checkpoint in m_checkpoint_path
+    std::chrono::milliseconds m_timeline_resolution {0}; // the length of each window in the timeline of the throughput & latency (0 = do not record the timeline)
+    details::EventLog m_event_log; // builds, epochs & garbage collections occurred while the experiment is running
+
+    details::Aging2Master* m_master = nullptr; // the instance running the experiment, protected by m_progress_mutex
+
+    // signal the threads waiting in #wait_for_progress
+    std::mutex m_progress_mutex; // sync the waiting threads with the workers
+    std::condition_variable m_progress_condvar; // as above
+    std::atomic<uint64_t> m_progress_target = std::numeric_limits<uint64_t>::max(); // the workers wake up the waiting threads once their estimate of the operations performed reaches this target
+    bool m_progress_done = false; // whether the experiment terminated, protected by m_progress_mutex
+    uint64_t m_num_operations_final = 0; // the operations performed by the master, saved when it terminates, protected by m_progress_mutex
+    double m_progress_final = 0; // the progress reached by the master, saved when it terminates, protected by m_progress_mutex
+
+    // Invoked by the workers after each chunk of operations, with the operations performed so far by all workers. The
+    // waiting threads aggregate the actual count and wait again if the target has not been reached yet.
+    void notify_progress(uint64_t num_operations){
+        if(num_operations >= m_progress_target.load(std::memory_order_relaxed)){ notify_progress(); }
+    }
+
+    // Wake up all threads waiting in #wait_for_progress
+    void notify_progress();
 
-    details::Aging2Master* m_master;
 public:
         std::shared_ptr<gfe::library::UpdateInterface> m_library; // the library to evaluate
 
@@ -74,12 +130,22 @@ public:
     // Set the path to the log file with all updates
     void set_log(const std::string& path_log);
 
+    // Generate the sequence of updates with the given synthetic log, rather than reading it from a graphlog file
+    void set_synthetic_log(std::shared_ptr<details::SyntheticLog> synthetic_log);
+
     // Set the max weight for the edges created
     void set_max_weight(double value);
 
     // Set the number of client threads to use in the experiment, that is, the parallelism degree
     void set_parallelism_degree(uint64_t num_threads);
 
+    // Set the number of threads that run the analytics concurrently to the updates, as in the mixed workload. Each thread
+    // registers with the library with its own thread_id, see #reader_thread_id
+    void set_num_reader_threads(uint64_t num_threads);
+
+    // The thread_id to register with the library the given thread running the analytics, in [0, #set_num_reader_threads)
+    int reader_thread_id(uint64_t reader) const;
+
     // Set how frequently create a new snapshot/delta in the library (0 = do not create new snapshots)
     void set_build_frequency(std::chrono::milliseconds millisecs);
 
@@ -118,16 +184,73 @@ public:
     // Forcedly stop the execution of the experiment when the readings of the memory footprint are above this threshold (0 = infinite)
     void set_memfp_threshold(uint64_t value);
 
+    // Open-loop mode. Each worker issues the updates at the given target rate, in operations per second, rather than
+    // as fast as the library completes them. The latency is measured from the time an update was scheduled to be sent,
+    // including the time it has been queued behind the previous updates. A rate of 0 restores the closed-loop mode.
+    void set_arrival_rate(double ops_per_sec);
+
+    // Open-loop mode, whether the inter-arrival times are constant or follow a Poisson process
+    void set_arrival_process(ArrivalProcess process);
+
+    // How to pin the worker threads to the logical CPUs and NUMA nodes. When a worker is pinned and the updates are
+    // loaded upfront, its buffers of updates are allocated on its local NUMA node. In the streaming mode, the buffers are
+    // allocated by the decoder thread, hence their placement is not affected by this setting.
+    void set_worker_placement(ThreadPlacement placement);
+
+    // Interleave point lookups with the updates: has_edge, get_weight and has_vertex, chosen at random. The ratio is the
+    // fraction of the operations performed by each worker that are reads, in [0, 1). The latency of the reads is
+    // recorded separately from the updates, when measuring the latency.
+    void set_read_ratio(double ratio);
+
+    // Whether the point lookups target the edges recently updated by the same worker or random edges from the log
+    void set_read_target(ReadTarget target);
+
+    // Send the updates to the library in batches of the given size, through the method #update_batch. The batches never
+    // exceed the granularity of a worker task. A size of 1 sends one update at the time, with #add_edge_v2 and #remove_edge.
+    // When measuring the latency, each update is assigned the latency of the whole batch.
+    void set_update_batch_size(uint64_t value);
+
+    // Periodically save the progress of the experiment in the given file, together with a snapshot of the graph when the
+    // library supports it (UpdateInterface#save_snapshot). The workers are paused at the end of their current chunk of updates
+    // while the checkpoint is taken. The time spent to take the checkpoint is not included in the completion time.
+    void set_checkpoint(const std::string& path, std::chrono::seconds interval);
+
+    // Resume the experiment from the checkpoint set with #set_checkpoint, rather than from the start of the log
+    void set_resume(bool value);
+
+    // Record the throughput and the latency of the updates in windows of the given length (0 = disabled). The minimum resolution is 100 ms.
+    void set_timeline_resolution(std::chrono::milliseconds millisecs);
+
+    // Streaming mode. Rather than loading all updates in memory before starting, decode the log in a background thread
+    // while the experiment runs, queueing up to `depth' blocks for each worker (0 = disabled, load all updates upfront).
+    // It does not support the measurement of the latency and resuming from a checkpoint.
+    void set_streaming(uint64_t depth);
+
     // [Internal parameter]
     // Set the granularity of a task for a worker thread. This is the number of contiguos operations (inserts/deletes) done
     // by each worker thread between each invocation to the scheduler.
     void set_worker_granularity(uint64_t value);
 
+    // Adapt the granularity of the worker threads at runtime, so that each chunk of updates takes about the given wall time.
+    // The granularity set with #set_worker_granularity becomes the initial size of a chunk. A target of 0 keeps the granularity fixed.
+    void set_worker_granularity_target(std::chrono::microseconds target);
+
     // Execute the experiment with the given configuration
     // @param reset_graph if true, release the contained graph before running the experiment, to save some memory
     Aging2Result execute();
 
     double progress_so_far();
+
+    // Block until the workers performed at least the given number of updates, or the given fraction of all updates, whichever
+    // is greater. It relies on the notifications from the workers, rather than polling.
+    // @return true if the target has been reached, false if the experiment terminated beforehand
+    bool wait_for_progress(uint64_t num_operations, double progress = 0);
+
+    // Number of updates performed so far by the workers, 0 if the experiment has not started, the final count once it terminated
+    uint64_t num_operations_sofar();
+
+    // Register of the builds, epochs and garbage collections occurred during the experiment, reported in the timeline
+    details::EventLog& event_log() { return m_event_log; }
 };
 
 } // namespace
@@ -21,6 +21,7 @@
 
 #include "common/database.hpp"
 #include "common/error.hpp"
+#include "details/hardware_counters.hpp"
 #include "details/latency.hpp"
 #include "aging2_experiment.hpp"
 
@@ -29,7 +30,14 @@ using namespace std;
 
 namespace gfe::experiment {
 
-Aging2Result::Aging2Result(const Aging2Experiment& parameters) : m_num_threads(parameters.m_num_threads), m_worker_granularity(parameters.m_worker_granularity){
+Aging2Result::Aging2Result(const Aging2Experiment& parameters) : m_num_threads(parameters.m_num_threads), m_worker_granularity(parameters.m_worker_granularity),
+        m_worker_granularity_target(parameters.m_worker_granularity_target.count()),
+        m_timeline_resolution(parameters.m_timeline_resolution.count()),
+        m_update_batch_size(parameters.m_update_batch_size),
+        m_synthetic_pattern(parameters.m_synthetic_log.get() != nullptr ? details::synthetic_pattern_to_string(parameters.m_synthetic_log->pattern()) : ""),
+        m_streaming_depth(parameters.m_streaming_depth),
+        m_read_ratio(parameters.m_read_ratio), m_read_target(parameters.m_read_target == ReadTarget::RANDOM ? "random" : "recent"),
+        m_arrival_rate(parameters.m_arrival_rate), m_arrival_process(parameters.m_arrival_process == ArrivalProcess::POISSON ? "poisson" : "constant"){
 
 }
 
@@ -43,7 +51,9 @@ void Aging2Result::save(common::Database* handle) {
 
     auto db = handle->add("aging");
     db.add("granularity", m_worker_granularity);
+    db.add("granularity_target", m_worker_granularity_target); // microsecs, 0 => fixed granularity
     db.add("num_threads", m_num_threads);
+    db.add("update_batch_size", m_update_batch_size);
     db.add("num_updates", m_num_operations_total);
     db.add("num_artificial_vertices", m_num_artificial_vertices);
     db.add("num_vertices_load", m_num_vertices_load);
@@ -57,6 +67,43 @@ void Aging2Result::save(common::Database* handle) {
     db.add("has_terminated_for_memfp", (int64_t) m_memfp_threshold_passed);
     db.add("has_terminated_deadlocked", (int64_t) m_thread_deadlocked);
     db.add("has_terminated_deadlocked_in_library", (int64_t) m_in_library_code);
+    if(!m_synthetic_pattern.empty()){ // updates generated by the driver
+        db.add("synthetic_pattern", m_synthetic_pattern);
+    }
+    if(m_streaming_depth > 0){ // updates decoded while the experiment runs
+        db.add("streaming_depth", m_streaming_depth);
+    }
+    if(m_read_ratio > 0){ // point lookups
+        db.add("read_ratio", m_read_ratio);
+        db.add("read_target", m_read_target);
+        db.add("num_reads", m_num_reads);
+        db.add("num_reads_found", m_num_reads_found);
+    }
+    if(m_arrival_rate > 0){ // open loop
+        db.add("arrival_rate", m_arrival_rate); // per worker, ops/sec
+        db.add("arrival_process", m_arrival_process);
+        db.add("num_late_operations", m_num_late_operations);
+    }
+
+    for(uint64_t i = 0, sz = m_worker_granularities.size(); i < sz; i++){
+        const auto& worker = m_worker_granularities[i];
+        auto db = handle->add("aging_granularity");
+        db.add("worker_id", (int64_t) i +1); // 1, 2, 3...
+        db.add("num_chunks", worker.m_num_chunks);
+        db.add("granularity_min", worker.m_min);
+        db.add("granularity_max", worker.m_max);
+        db.add("granularity_avg", worker.m_avg);
+        db.add("granularity_last", worker.m_last);
+    }
+
+    if(m_synthetic_pattern.empty()){ // removal of the artificial vertices, a synthetic log does not create any
+        auto db = handle->add("aging_remove_vertices");
+        db.add("num_vertices", m_num_artificial_vertices);
+        db.add("num_removed", m_num_vertices_removed);
+        db.add("num_stolen", m_num_vertices_stolen);
+        db.add("completion_time", m_remove_vertices_time); // microseconds
+        db.add("vertices_per_sec", m_remove_vertices_time > 0 ? m_num_artificial_vertices * 1000000ull / m_remove_vertices_time : 0ull);
+    }
 
     for(int i = 0, sz = m_reported_times.size(); i < sz; i++){
       if(m_reported_times[i] == 0) continue; // missing??
@@ -76,14 +123,46 @@ void Aging2Result::save(common::Database* handle) {
     db.add("tick", record.m_tick );
     db.add("memfp_process", record.m_memory_process );
     db.add("memfp_driver", record.m_memory_driver );
+    db.add("memfp_library", record.m_memory_library );
     db.add("cooloff", (int64_t) record.m_is_cooloff);
   }
 
+  for(uint64_t i = 0, sz = m_timeline.size(); i < sz; i++){
+    const auto& window = m_timeline[i];
+    auto db = handle->add("aging_timeline");
+    db.add("window", (int64_t) i);
+    db.add("time_start", i * m_timeline_resolution); // millisecs
+    db.add("resolution", m_timeline_resolution); // millisecs
+    db.add("num_insertions", window.m_num_insertions);
+    db.add("num_deletions", window.m_num_deletions);
+    db.add("insertions_per_sec", window.m_num_insertions * 1000 / m_timeline_resolution);
+    db.add("deletions_per_sec", window.m_num_deletions * 1000 / m_timeline_resolution);
+    db.add("latency_p50", window.m_latency_p50); // nanosecs
+    db.add("latency_p99", window.m_latency_p99);
+    db.add("latency_p999", window.m_latency_p999);
+    db.add("num_builds", window.m_num_builds);
+    db.add("time_builds", window.m_time_builds); // microsecs
+    db.add("num_epochs", window.m_num_epochs);
+    db.add("time_epochs", window.m_time_epochs);
+    db.add("num_gc", window.m_num_gc);
+    db.add("time_gc", window.m_time_gc);
+  }
+
+    if(m_hardware_counters.get() != nullptr){
+        m_hardware_counters->save(handle);
+    }
+
     if(m_latency_stats.get() != nullptr){
         m_latency_stats[0].save("inserts");
         m_latency_stats[1].save("deletes");
         m_latency_stats[2].save("updates");
     }
+    if(m_latency_stats_reads.get() != nullptr){
+        m_latency_stats_reads->save("reads");
+    }
+    if(m_latency_stats_remove_vertices.get() != nullptr){
+        m_latency_stats_remove_vertices->save("remove_vertices");
+    }
 }
 
 void Aging2Result::save(std::shared_ptr<common::Database> db){
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <vector>
 
 // forward declarations
@@ -25,6 +26,7 @@ namespace common { class Database; }
 namespace gfe::experiment { class Aging2Experiment; }
 namespace gfe::experiment::details { class Aging2Master; }
 namespace gfe::experiment::details { class Aging2Worker; }
+namespace gfe::experiment::details { class HardwareCountersLog; }
 namespace gfe::experiment::details { class LatencyStatistics; }
 
 namespace gfe::experiment {
@@ -38,6 +40,15 @@ class Aging2Result {
 
     const uint64_t m_num_threads; // the total number of threads used for the experiment, that is, the parallelism degree
     const uint64_t m_worker_granularity; // the granularity of a task for a worker, that is the number of contiguous operations (inserts/deletes) performed inside the threads between each invocation to the scheduler.
+    const uint64_t m_worker_granularity_target; // adaptive granularity, the target wall time for each chunk of operations, in microsecs (0 = fixed granularity)
+    struct WorkerGranularity {
+        uint64_t m_num_chunks; // number of chunks executed by the worker
+        uint64_t m_min; // smallest granularity chosen
+        uint64_t m_max; // largest granularity chosen
+        uint64_t m_avg; // average number of operations per chunk
+        uint64_t m_last; // the granularity in use at the end of the experiment
+    };
+    std::vector<WorkerGranularity> m_worker_granularities; // adaptive granularity, the values chosen by each worker
     uint64_t m_num_artificial_vertices = 0; // the total number of artificial vertices (not present in the loaded graph), inserted during the updates
     uint64_t m_completion_time = 0; // the amount of time to complete all updates, in microsecs
     uint64_t m_num_vertices_load = 0; // the number of vertices loaded from the input graph
@@ -49,14 +60,51 @@ class Aging2Result {
     uint64_t m_num_operations_total = 0; // total number of operations expected to be performed by the workers
     std::vector<uint64_t> m_reported_times; // time to complete 1x, 2x, 3x, ... updates (inserts/deletions) w.r.t. the size of the input graph, in microsecs
     std::vector<uint64_t> m_progress; // number of operations performed after each seconds of the execution
-    struct MemoryFootprint { uint64_t m_tick; uint64_t m_memory_process; uint64_t m_memory_driver; bool m_is_cooloff; };
+    struct MemoryFootprint {
+        uint64_t m_tick;
+        uint64_t m_memory_process; // the memory footprint of the whole process
+        uint64_t m_memory_driver; // estimate of the memory used by the driver, the buffers of the workers
+        uint64_t m_memory_library; // the memory allocated while executing the library code, as tracked by the memory profiler (0 = not available)
+        bool m_is_cooloff;
+    };
     std::vector<MemoryFootprint> m_memory_footprint;
+    const uint64_t m_timeline_resolution; // the length of each window in the timeline, in millisecs (0 = timeline not recorded)
+    struct TimelineWindow {
+        uint64_t m_num_insertions; // number of edge insertions completed in the window
+        uint64_t m_num_deletions; // number of edge deletions completed in the window
+        uint64_t m_latency_p50; // median latency of the updates completed in the window, in nanosecs (0 => latency not measured)
+        uint64_t m_latency_p99; // 99th percentile, in nanosecs
+        uint64_t m_latency_p999; // 99.9th percentile, in nanosecs
+        uint64_t m_num_builds; // number of invocations to #build() started in the window
+        uint64_t m_time_builds; // time spent in #build() inside the window, in microsecs
+        uint64_t m_num_epochs; // number of epochs created in the window
+        uint64_t m_time_epochs; // time spent creating the epochs inside the window, in microsecs
+        uint64_t m_num_gc; // number of invocations to the garbage collector started in the window
+        uint64_t m_time_gc; // time spent in the garbage collector inside the window, in microsecs
+    };
+    std::vector<TimelineWindow> m_timeline; // throughput, latency and maintenance events for each window of the experiment
+    const uint64_t m_update_batch_size; // the number of updates sent by a worker in a single invocation to #update_batch
+    const std::string m_synthetic_pattern; // the pattern of the synthetic log generated by the driver (empty => updates read from a graphlog)
+    const uint64_t m_streaming_depth; // streaming mode, the max number of decoded blocks queued for each worker (0 = all updates loaded upfront)
+    const double m_read_ratio; // the fraction of operations that are point lookups
+    const std::string m_read_target; // which edges are looked up by the point reads, either recent or random
+    uint64_t m_num_reads = 0; // total number of point lookups performed
+    uint64_t m_num_reads_found = 0; // number of point lookups that found the searched vertex/edge
+    std::shared_ptr<details::LatencyStatistics> m_latency_stats_reads; // the latency of the point lookups (nullptr => not measured)
+    const double m_arrival_rate; // open-loop mode, the target number of updates per second issued by each worker (0 = closed loop)
+    const std::string m_arrival_process; // open-loop mode, the distribution of the inter-arrival times
+    uint64_t m_num_late_operations = 0; // open-loop mode, number of updates sent after their scheduled time, because the worker was still busy with the previous updates
     uint64_t m_random_vertex_id = 0; // the ID of a random vertex stored in the graph
     std::shared_ptr<details::LatencyStatistics[]> m_latency_stats; // 3 items, 0 = insertions, 1 = deletions, 2 = both insertions & deletions
+    uint64_t m_remove_vertices_time = 0; // the amount of time to remove the artificial vertices at the end of the experiment, in microsecs
+    uint64_t m_num_vertices_removed = 0; // the number of artificial vertices effectively removed, that is, #remove_vertex returned true
+    uint64_t m_num_vertices_stolen = 0; // the number of artificial vertices removed by a worker different than the one they were assigned to
+    std::shared_ptr<details::LatencyStatistics> m_latency_stats_remove_vertices; // the latency of the vertex removals (nullptr => not measured)
     bool m_timeout_hit = false; // whether the experiment terminated due to the internal timeout
     bool m_memfp_threshold_passed = false; // whether the experiment terminated due to the excessive usage of memory
     bool m_thread_deadlocked = false; // Whether a worker thread deadlocked
     bool m_in_library_code = false; // Whether a worker thread deadlocked in library code
+    std::shared_ptr<details::HardwareCountersLog> m_hardware_counters; // the hardware counters for each phase of the experiment (nullptr => not recorded)
 
 public:
     // Default ctor
@@ -70,6 +118,21 @@ public:
         return m_num_artificial_vertices;
     }
 
+    // The time to perform all updates, in microsecs
+    uint64_t completion_time() const {
+        return m_completion_time;
+    }
+
+    // The total number of updates (insertions & deletions) in the experiment
+    uint64_t num_operations_total() const {
+        return m_num_operations_total;
+    }
+
+    // The time to complete 1x, 2x, 3x, ... updates w.r.t. the size of the final graph, in microsecs
+    const std::vector<uint64_t>& reported_times() const {
+        return m_reported_times;
+    }
+
     // Get a random vertex stored in the graph
     uint64_t get_random_vertex_id() const {
         return m_random_vertex_id;
@@ -0,0 +1,144 @@
+/**
+ * Copyright (C) 2019 Dean De Leo, email: dleo[at]cwi.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "calibration.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <memory>
+#if defined(HAVE_OPENMP)
+#include <omp.h>
+#endif
+
+#include "common/database.hpp"
+#include "common/error.hpp"
+#include "common/quantity.hpp"
+#include "common/timer.hpp"
+#include "details/synthetic_log.hpp"
+#include "graph/edge_stream.hpp"
+#include "library/baseline/dummy.hpp"
+#include "aging2_experiment.hpp"
+#include "configuration.hpp"
+#include "graphalytics.hpp"
+#include "insert_only.hpp"
+
+using namespace common;
+using namespace std;
+
+namespace gfe::experiment {
+
+Calibration::Calibration(const std::string& path_graph, bool is_directed, uint64_t max_num_threads) :
+        m_path_graph(path_graph), m_is_directed(is_directed), m_max_num_threads(max_num_threads) {
+    if(m_max_num_threads == 0) INVALID_ARGUMENT("Invalid number of threads: 0");
+}
+
+void Calibration::set_aging_coeff(double value){
+    if(value < 1) INVALID_ARGUMENT("The aging coefficient must be >= 1: " << value);
+    m_aging_coeff = value;
+}
+
+void Calibration::set_num_repetitions(uint64_t value){
+    if(value == 0) INVALID_ARGUMENT("The number of repetitions cannot be zero");
+    m_num_repetitions = value;
+}
+
+void Calibration::run_insert_only(uint64_t num_threads){
+    auto library = make_shared<library::Dummy>(m_is_directed);
+    auto stream = make_shared<graph::WeightedEdgeStream>(m_path_graph);
+    stream->permute();
+    const uint64_t num_edges = stream->num_edges();
+
+    InsertOnly experiment { library, stream, static_cast<int64_t>(num_threads) };
+    experiment.set_scheduler_granularity(configuration().get_insertion_granularity());
+    experiment.set_scheduler(parse_insertion_scheduler(configuration().get_insertion_scheduler()));
+    experiment.set_worker_placement(details::parse_thread_placement(configuration().get_insertion_placement()));
+    auto completion_time = experiment.execute();
+
+    m_runs.push_back(Run{ "insert_only", num_threads, num_edges, static_cast<uint64_t>(completion_time.count()) });
+}
+
+void Calibration::run_aging2(uint64_t num_threads){
+    auto library = make_shared<library::Dummy>(m_is_directed);
+    auto synthetic_log = make_shared<details::SyntheticLog>(m_path_graph, SyntheticPattern::UNIFORM, m_aging_coeff, configuration().seed());
+
+    Aging2Experiment experiment;
+    experiment.set_library(library);
+    experiment.set_synthetic_log(synthetic_log);
+    experiment.set_parallelism_degree(num_threads);
+    experiment.set_worker_granularity_target(chrono::microseconds{configuration().get_aging_granularity_target()});
+    auto result = experiment.execute();
+
+    m_runs.push_back(Run{ "aging2", num_threads, result.num_operations_total(), result.completion_time() });
+}
+
+void Calibration::run_graphalytics(uint64_t num_threads){
+#if defined(HAVE_OPENMP)
+    omp_set_num_threads(num_threads);
+#endif
+    auto library = make_shared<library::Dummy>(m_is_directed);
+
+    GraphalyticsAlgorithms properties;
+    properties.bfs.m_enabled = true;
+    properties.cdlp.m_enabled = true;
+    properties.lcc.m_enabled = true;
+    properties.pagerank.m_enabled = true;
+    properties.sssp.m_enabled = true;
+    properties.wcc.m_enabled = true;
+    constexpr uint64_t num_kernels = 6;
+
+    GraphalyticsSequential experiment { library, m_num_repetitions, properties };
+    auto completion_time = experiment.execute();
+
+    m_runs.push_back(Run{ "graphalytics", num_threads, num_kernels * m_num_repetitions, static_cast<uint64_t>(completion_time.count()) });
+}
+
+void Calibration::execute(){
+    vector<uint64_t> thread_counts;
+    for(uint64_t num_threads = 1; num_threads < m_max_num_threads; num_threads *= 2){ thread_counts.push_back(num_threads); }
+    thread_counts.push_back(m_max_num_threads);
+
+    for(uint64_t num_threads : thread_counts){
+        LOG("[Calibration] Number of threads: " << num_threads);
+        run_insert_only(num_threads);
+        run_aging2(num_threads);
+        run_graphalytics(num_threads);
+    }
+
+    LOG("[Calibration] Overhead of the driver with the library dummy_v3:");
+    for(const auto& run : m_runs){
+        LOG("[Calibration] " << run.m_experiment << ", threads: " << run.m_num_threads << ", operations: " << run.m_num_operations << ", "
+                "completion time: " << DurationQuantity(run.m_completion_time * 1000) << ", "
+                "throughput: " << (run.m_completion_time > 0 ? run.m_num_operations * 1000000ull / run.m_completion_time : 0ull) << " ops/sec, "
+                "overhead: " << (run.m_num_operations > 0 ? run.m_completion_time * 1000ull * run.m_num_threads / run.m_num_operations : 0ull) << " ns/op per thread");
+    }
+}
+
+void Calibration::save(){
+    assert(configuration().db() != nullptr);
+    for(const auto& run : m_runs){
+        auto db = configuration().db()->add("calibration");
+        db.add("experiment", run.m_experiment);
+        db.add("num_threads", run.m_num_threads);
+        db.add("num_operations", run.m_num_operations);
+        db.add("completion_time", run.m_completion_time); // microsecs
+        db.add("ops_per_sec", run.m_completion_time > 0 ? run.m_num_operations * 1000000ull / run.m_completion_time : 0ull);
+        db.add("overhead_per_op", run.m_num_operations > 0 ? run.m_completion_time * 1000ull * run.m_num_threads / run.m_num_operations : 0ull); // nanosecs, per thread
+    }
+}
+
+} // namespace
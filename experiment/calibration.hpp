@@ -0,0 +1,79 @@
+/**
+ * Copyright (C) 2019 Dean De Leo, email: dleo[at]cwi.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cinttypes>
+#include <string>
+#include <vector>
+
+namespace gfe::experiment {
+
+/**
+ * Measure the overhead of the driver itself. The experiments InsertOnly, Aging2 and the Graphalytics suite are executed
+ * against the library `dummy_v3', where all operations are nop, with an increasing number of threads: 1, 2, 4, ... up to
+ * the max number of threads given. The throughput observed is the max achievable by the driver, and its inverse is the
+ * overhead per operation, which can be subtracted from the results of the actual libraries.
+ */
+class Calibration {
+    // The outcome of a single run
+    struct Run {
+        std::string m_experiment; // insert_only, aging2 or graphalytics
+        uint64_t m_num_threads; // the number of threads used
+        uint64_t m_num_operations; // the number of operations performed: updates or kernel invocations
+        uint64_t m_completion_time; // the time to perform all operations, in microsecs
+    };
+
+    const std::string m_path_graph; // the graph used to generate the operations
+    const bool m_is_directed; // whether the graph is directed
+    const uint64_t m_max_num_threads; // the max number of threads to evaluate
+    double m_aging_coeff = 10.0; // the number of updates in the Aging2 experiment, w.r.t. the number of edges in the graph
+    uint64_t m_num_repetitions = 10; // number of times each Graphalytics kernel is invoked
+    std::vector<Run> m_runs; // the results
+
+    // Execute the experiment InsertOnly with the given number of threads
+    void run_insert_only(uint64_t num_threads);
+
+    // Execute the experiment Aging2 with the given number of threads
+    void run_aging2(uint64_t num_threads);
+
+    // Execute the Graphalytics suite with the given number of threads
+    void run_graphalytics(uint64_t num_threads);
+
+public:
+    /**
+     * Initialise the calibration
+     * @param path_graph the graph used to generate the insertions and the updates
+     * @param is_directed whether the graph is directed
+     * @param max_num_threads the max number of threads to evaluate
+     */
+    Calibration(const std::string& path_graph, bool is_directed, uint64_t max_num_threads);
+
+    // Set the number of updates in the Aging2 experiment, w.r.t. the number of edges in the graph
+    void set_aging_coeff(double value);
+
+    // Set how many times each Graphalytics kernel is invoked
+    void set_num_repetitions(uint64_t value);
+
+    // Execute all runs
+    void execute();
+
+    // Store the results into the database
+    void save();
+};
+
+} // namespace
@@ -0,0 +1,93 @@
+/**
+ * Copyright (C) 2019 Dean De Leo, email: dleo[at]cwi.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "aging2_checkpoint.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+#include "common/error.hpp"
+
+using namespace std;
+
+namespace gfe::experiment::details {
+
+static constexpr uint64_t CHECKPOINT_VERSION = 1;
+
+void Aging2Checkpoint::save(const std::string& path) const {
+    string path_tmp = path + ".tmp";
+    fstream handle(path_tmp, ios_base::out | ios_base::trunc);
+    if(!handle.good()) ERROR("Cannot open the file `" << path_tmp << "' to save the checkpoint");
+
+    handle << "version " << CHECKPOINT_VERSION << "\n";
+    handle << "path_log " << m_path_log << "\n";
+    handle << "num_threads " << m_num_threads << "\n";
+    handle << "elapsed_time " << m_elapsed_time << "\n";
+    handle << "num_operations_performed " << m_num_operations_performed << "\n";
+    handle << "last_time_reported " << m_last_time_reported << "\n";
+    handle << "has_snapshot " << m_has_snapshot << "\n";
+    handle << "reported_times " << m_reported_times.size();
+    for(auto t : m_reported_times){ handle << " " << t; }
+    handle << "\n";
+    handle << "worker_positions " << m_worker_positions.size();
+    for(auto p : m_worker_positions){ handle << " " << p; }
+    handle << "\n";
+
+    handle.close();
+    if(handle.fail()) ERROR("Error while writing the checkpoint to `" << path_tmp << "'");
+
+    if(::rename(path_tmp.c_str(), path.c_str()) != 0){
+        ERROR("Cannot rename the checkpoint `" << path_tmp << "' into `" << path << "'");
+    }
+}
+
+Aging2Checkpoint Aging2Checkpoint::load(const std::string& path) {
+    fstream handle(path, ios_base::in);
+    if(!handle.good()) ERROR("Cannot open the checkpoint `" << path << "'");
+
+    Aging2Checkpoint checkpoint;
+    string key;
+    uint64_t version = 0;
+    handle >> key >> version;
+    if(key != "version" || version != CHECKPOINT_VERSION) ERROR("Invalid checkpoint `" << path << "', unsupported format");
+
+    // the path of the graphlog may contain spaces
+    handle >> key; handle.ignore(1); getline(handle, checkpoint.m_path_log);
+    handle >> key >> checkpoint.m_num_threads;
+    handle >> key >> checkpoint.m_elapsed_time;
+    handle >> key >> checkpoint.m_num_operations_performed;
+    handle >> key >> checkpoint.m_last_time_reported;
+    handle >> key >> checkpoint.m_has_snapshot;
+    uint64_t sz = 0;
+    handle >> key >> sz;
+    checkpoint.m_reported_times.resize(sz);
+    for(uint64_t i = 0; i < sz; i++){ handle >> checkpoint.m_reported_times[i]; }
+    handle >> key >> sz;
+    checkpoint.m_worker_positions.resize(sz);
+    for(uint64_t i = 0; i < sz; i++){ handle >> checkpoint.m_worker_positions[i]; }
+
+    if(handle.fail()) ERROR("The checkpoint `" << path << "' is truncated or corrupted");
+    if(checkpoint.m_worker_positions.size() != checkpoint.m_num_threads) ERROR("The checkpoint `" << path << "' is corrupted, mismatch in the number of workers");
+
+    return checkpoint;
+}
+
+std::string Aging2Checkpoint::snapshot_path(const std::string& path) {
+    return path + ".graph";
+}
+
+} // namespace
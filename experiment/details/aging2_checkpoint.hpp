@@ -0,0 +1,58 @@
+/**
+ * Copyright (C) 2019 Dean De Leo, email: dleo[at]cwi.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cinttypes>
+#include <string>
+#include <vector>
+
+namespace gfe::experiment::details {
+
+/**
+ * The progress of an Aging2 experiment, periodically persisted to disk so that a run can be resumed at the same
+ * point of the graphlog, rather than re-executing all updates from the start. The graph itself is saved aside by the
+ * library, through UpdateInterface#save_snapshot, in the file #snapshot_path().
+ */
+struct Aging2Checkpoint {
+    std::string m_path_log; // the graphlog being executed
+    uint64_t m_num_threads = 0; // number of worker threads, the updates are partitioned among the workers according to this value
+    uint64_t m_elapsed_time = 0; // time spent executing the updates so far, in microsecs
+    uint64_t m_num_operations_performed = 0; // total number of updates performed so far, by all workers
+    int64_t m_last_time_reported = 0; // the last aging coefficient reported, as in Aging2Master#m_last_time_reported
+    std::vector<uint64_t> m_reported_times; // how long it took to perform 1x, 2x, 3x, ... updates, in microsecs
+    std::vector<uint64_t> m_worker_positions; // for each worker, the number of updates already performed from its own sequence
+    bool m_has_snapshot = false; // whether the library saved a snapshot of the graph
+
+    /**
+     * Store the checkpoint in the given file. The file is first written into a temporary path and then renamed,
+     * so that a crash while saving the checkpoint never leaves behind a partially written file.
+     */
+    void save(const std::string& path) const;
+
+    /**
+     * Load the checkpoint from the given file
+     */
+    static Aging2Checkpoint load(const std::string& path);
+
+    /**
+     * The path of the snapshot of the graph associated to the given checkpoint file
+     */
+    static std::string snapshot_path(const std::string& path);
+};
+
+} // namespace
@@ -17,11 +17,15 @@
 
 #include "aging2_master.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <mutex>
+#include <random>
 #include <thread>
 #include <utility>
 
@@ -34,10 +38,15 @@
 #include "reader/graphlog_reader.hpp"
 #include "library/interface.hpp"
 #include "utility/memory_usage.hpp"
+#include "aging2_checkpoint.hpp"
 #include "aging2_worker.hpp"
+#include "bounded_queue.hpp"
 #include "build_thread.hpp"
 #include "configuration.hpp"
+#include "event_log.hpp"
+#include "hardware_counters.hpp"
 #include "latency.hpp"
+#include "synthetic_log.hpp"
 
 using namespace common;
 using namespace std;
@@ -67,24 +76,39 @@ namespace gfe::experiment::details {
 Aging2Master::Aging2Master(Aging2Experiment& parameters) :
     m_parameters(parameters),
     m_is_directed(m_parameters.m_library->is_directed()),
+    m_filter_updates(m_parameters.m_synthetic_log.get() == nullptr), // the operations of a synthetic log must be all performed
     m_results(parameters) {
 
-    auto properties = reader::graphlog::parse_properties(parameters.m_path_log);
-    m_results.m_num_artificial_vertices = stoull(properties["internal.vertices.temporary.cardinality"]);
-    m_results.m_num_vertices_load = stoull(properties["internal.vertices.final.cardinality"]);
-    m_results.m_num_edges_load = stoull(properties["internal.edges.final"]);
-    m_results.m_num_operations_total = stoull(properties["internal.edges.cardinality"]);
+    if(parameters.m_synthetic_log.get() != nullptr){ // the updates are generated by the driver
+        const SyntheticLog* synthetic = parameters.m_synthetic_log.get();
+        m_results.m_num_artificial_vertices = 0;
+        m_results.m_num_vertices_load = synthetic->num_vertices();
+        m_results.m_num_edges_load = synthetic->num_edges_final();
+        m_results.m_num_operations_total = synthetic->num_operations();
+    } else {
+        auto properties = reader::graphlog::parse_properties(parameters.m_path_log);
+        m_results.m_num_artificial_vertices = stoull(properties["internal.vertices.temporary.cardinality"]);
+        m_results.m_num_vertices_load = stoull(properties["internal.vertices.final.cardinality"]);
+        m_results.m_num_edges_load = stoull(properties["internal.edges.final"]);
+        m_results.m_num_operations_total = stoull(properties["internal.edges.cardinality"]);
+    }
 
     // 1024 is a hack to avoid issues with small graphs
-    m_reported_times = new uint64_t[static_cast<uint64_t>( m_parameters.m_num_reports_per_operations * ::ceil( static_cast<double>(num_operations_total())/num_edges_final_graph()) + 1 )]();
+    m_reported_times_sz = static_cast<uint64_t>( m_parameters.m_num_reports_per_operations * ::ceil( static_cast<double>(num_operations_total())/num_edges_final_graph()) + 1 );
+    m_reported_times = new uint64_t[m_reported_times_sz]();
+
+    m_parameters.m_library->on_main_init(m_parameters.m_num_threads + /* this + builder service */ 2 + /* the analytic clients (mixed experiment) */ m_parameters.m_num_reader_threads);
 
-    m_parameters.m_library->on_main_init(m_parameters.m_num_threads + /* this + builder service */ 2 + /* plus potentially an analytics runner (mixed epxeriment) */ 1);
+    if(configuration().measure_hardware_counters()){ // before the workers are started
+        m_results.m_hardware_counters = make_shared<HardwareCountersLog>("aging2");
+    }
 
     init_workers();
     m_parameters.m_library->on_thread_init(m_parameters.m_num_threads + 1);
 }
 
 Aging2Master::~Aging2Master(){
+    timeline_stop();
     for(auto w: m_workers){ delete w; }
     m_workers.clear();
     m_parameters.m_library->on_thread_destroy(m_parameters.m_num_threads + 1);
@@ -113,6 +137,8 @@ void Aging2Master::init_workers() {
  *                                                                           *
  *****************************************************************************/
 void Aging2Master::load_edges(){
+    if(m_parameters.m_synthetic_log.get() != nullptr){ load_edges_synthetic(); return; }
+
     LOG("[Aging2] Loading the sequence of updates to perform from " << m_parameters.m_path_log << " ...");
     Timer timer; timer.start();
 
@@ -146,6 +172,140 @@ void Aging2Master::load_edges(){
     LOG("[Aging2] Graphlog loaded in " << timer);
 }
 
+void Aging2Master::load_edges_synthetic(){
+    SyntheticLog* synthetic = m_parameters.m_synthetic_log.get();
+    LOG("[Aging2] Generating the sequence of updates to perform, pattern: " << synthetic_pattern_to_string(synthetic->pattern()) << ", "
+            "aging coefficient: " << synthetic->aging_coeff() << ", operations: " << synthetic->num_operations() << " ...");
+    Timer timer; timer.start();
+
+    uint64_t array_sz = synthetic->block_size();
+    unique_ptr<uint64_t[]> ptr_array1 { new uint64_t[array_sz] };
+    unique_ptr<uint64_t[]> ptr_array2 { new uint64_t[array_sz] };
+    uint64_t* array1 = ptr_array1.get();
+    uint64_t* array2 = ptr_array2.get();
+
+    uint64_t num_edges = synthetic->load(array1, array_sz / 3);
+    while( num_edges > 0 ){
+        // partition the batch among the workers
+        for(auto w: m_workers) w->load_edges(array1, num_edges);
+        if(m_results.m_random_vertex_id == 0) { set_random_vertex_id(array1, num_edges); }
+
+        // generate the next batch in the meanwhile
+        num_edges = synthetic->load(array2, array_sz /3);
+
+        // wait for the workers to complete
+        for(auto w: m_workers) w->wait();
+
+        swap(array1,array2);
+    }
+
+    timer.stop();
+    LOG("[Aging2] Synthetic log generated in " << timer);
+}
+
+
+void Aging2Master::streaming_start(){
+    if(parameters().m_streaming_depth == 0) return; // streaming mode disabled
+    assert(!m_streaming_thread.joinable() && "The decoder is already running");
+    LOG("[Aging2] Streaming mode, decoding the updates while the experiment runs, queue depth: " << parameters().m_streaming_depth << " blocks per worker");
+
+    m_streaming_queues.clear();
+    for(uint64_t i = 0; i < m_workers.size(); i++){
+        m_streaming_queues.emplace_back( new BoundedQueue<vector<graph::WeightedEdge>*>(parameters().m_streaming_depth) );
+    }
+    m_streaming_thread = thread(&Aging2Master::main_streaming, this);
+}
+
+void Aging2Master::streaming_stop(){
+    if(!m_streaming_thread.joinable()) return; // not running
+
+    // on timeout, the workers may have left the updates in the queues. Unblock the decoder & release the updates left.
+    for(auto& queue : m_streaming_queues){ queue->close(); }
+    m_streaming_thread.join();
+    for(auto& queue : m_streaming_queues){
+        vector<graph::WeightedEdge>* buffer = nullptr;
+        while(queue->pop(buffer)){ delete buffer; }
+    }
+    m_streaming_queues.clear();
+    m_streaming_mem_usage = 0;
+}
+
+void Aging2Master::main_streaming(){
+    concurrency::set_thread_name("Aging2 Decoder");
+    const uint64_t num_workers = m_workers.size();
+    const double max_weight = parameters().m_max_weight;
+    const bool memfp_physical = parameters().m_memfp_physical;
+    mt19937_64 random { random_device{}() };
+    uniform_real_distribution<double> rndweight{0, max_weight}; // in [0, max_weight)
+
+    // the source of the updates, either the graphlog or the synthetic log
+    SyntheticLog* synthetic = m_parameters.m_synthetic_log.get();
+    fstream handle;
+    unique_ptr<reader::graphlog::EdgeLoader> loader;
+    uint64_t array_sz = 0;
+    if(synthetic != nullptr){
+        array_sz = synthetic->block_size();
+    } else {
+        handle.open(m_parameters.m_path_log, ios_base::in | ios_base::binary);
+        auto properties = reader::graphlog::parse_properties(handle);
+        array_sz = stoull(properties["internal.edges.block_size"]);
+        reader::graphlog::set_marker(properties, handle, reader::graphlog::Section::EDGES);
+        loader.reset( new reader::graphlog::EdgeLoader(handle) );
+    }
+    unique_ptr<uint64_t[]> ptr_array { new uint64_t[array_sz] };
+    uint64_t* array = ptr_array.get();
+
+    bool terminate = false;
+    uint64_t num_edges = 0;
+    while(!terminate && (num_edges = (synthetic != nullptr ? synthetic->load(array, array_sz / 3) : loader->load(array, array_sz / 3))) > 0){
+        if(m_results.m_random_vertex_id == 0) { set_random_vertex_id(array, num_edges); }
+
+        // partition the block among the workers, as in Aging2Worker#main_load_edges
+        uint64_t* __restrict sources = array;
+        uint64_t* __restrict destinations = sources + num_edges;
+        double* __restrict weights = reinterpret_cast<double*>(destinations + num_edges);
+        vector<unique_ptr<vector<graph::WeightedEdge>>> partitions;
+        for(uint64_t i = 0; i < num_workers; i++){
+            partitions.emplace_back( new vector<graph::WeightedEdge>() );
+            partitions.back()->reserve(num_edges / num_workers + 1);
+        }
+        for(uint64_t i = 0; i < num_edges; i++){
+            int worker_id = worker_of(sources[i], destinations[i]);
+            if(worker_id < 0) continue; // skip
+
+            double weight = weights[i];
+            if(weight == 0.0){ // generate a random weight
+                weight = rndweight(random); // in [0, max_weight)
+                if(weight == 0.0) weight = max_weight; // in (0, max_weight]
+            }
+            partitions[worker_id -1]->emplace_back(sources[i], destinations[i], weight);
+        }
+
+        // dispatch the partitions, waiting for the workers to consume the previous blocks
+        for(uint64_t i = 0; i < num_workers && !terminate; i++){
+            vector<graph::WeightedEdge>* buffer = partitions[i].get();
+            uint64_t mem_usage = memfp_physical ? buffer->size() * sizeof(graph::WeightedEdge) : utility::MemoryUsage::get_allocated_space(buffer->data());
+            m_streaming_mem_usage += mem_usage;
+            if(m_streaming_queues[i]->push(buffer)){
+                partitions[i].release(); // the ownership has been transferred to the worker
+            } else { // the queue has been closed, the experiment is over
+                m_streaming_mem_usage -= mem_usage;
+                terminate = true;
+            }
+        }
+    }
+
+    // signal to the workers the end of the log
+    for(auto& queue : m_streaming_queues){ queue->close(); }
+}
+
+vector<graph::WeightedEdge>* Aging2Master::streaming_next(int worker_id){
+    assert(worker_id >= 1 && worker_id <= (int) m_streaming_queues.size());
+    vector<graph::WeightedEdge>* buffer = nullptr;
+    if(!m_streaming_queues[worker_id -1]->pop(buffer)){ return nullptr; } // the log is over
+    m_streaming_mem_usage -= parameters().m_memfp_physical ? buffer->size() * sizeof(graph::WeightedEdge) : utility::MemoryUsage::get_allocated_space(buffer->data());
+    return buffer;
+}
 
 void Aging2Master::prepare_latencies(){
     LOG("[Aging2] Allocating space to record the latency of each update ...");
@@ -178,25 +338,39 @@ void Aging2Master::prepare_latencies(){
 void Aging2Master::do_run_experiment(){
     LOG("[Aging2] Experiment started ...");
     m_last_progress_reported = 0;
-    m_last_time_reported = 0; m_time_start = chrono::steady_clock::now();
+    m_num_operations_performed = num_operations_sofar(); // != 0 when resuming from a checkpoint
+    if(!parameters().m_resume){ m_last_time_reported = 0; } // otherwise restored from the checkpoint
+    m_time_start = chrono::steady_clock::now();
+
+    if(m_resume_elapsed_time > 0){ LOG("[Aging2] Resuming from " << DurationQuantity(m_resume_elapsed_time * 1000) << " of updates already performed"); }
 
     // init the build service (the one that creates the new snapshots/deltas)
-    BuildThread build_service { parameters().m_library , static_cast<int>(parameters().m_num_threads) + 2, parameters().m_build_frequency };
+    BuildThread build_service { parameters().m_library , static_cast<int>(parameters().m_num_threads) + 2, parameters().m_build_frequency, &m_parameters.m_event_log };
 
     auto start_time = chrono::steady_clock::now();
     Timer timer; timer.start();
     m_parameters.m_library->updates_start();
+    streaming_start();
     for(auto w: m_workers) w->execute_updates();
     m_experiment_running = true;
+    timeline_start();
     wait_and_record();
+    streaming_stop();
     build_service.stop();
+    auto t0 = chrono::steady_clock::now();
+    utility::MemoryUsage::set_library_scope(true);
     m_parameters.m_library->build(); // flush last changes
+    utility::MemoryUsage::set_library_scope(false);
+    m_parameters.m_event_log.record(EventLog::Type::BUILD, t0, chrono::steady_clock::now());
+    timeline_stop();
     m_parameters.m_library->updates_stop();
     timer.stop();
     LOG("[Aging2] Experiment completed!");
     LOG("[Aging2] Updates performed with " << parameters().m_num_threads << " threads in " << timer);
+    record_hardware_counters("run");
     cooloff(start_time);
-    m_results.m_completion_time = timer.microseconds();
+    record_hardware_counters("cooloff");
+    m_results.m_completion_time = timer.microseconds() + m_resume_elapsed_time - m_checkpoint_time;
     m_results.m_num_build_invocations = build_service.num_invocations();
     m_results.m_num_levels_created = m_parameters.m_library->num_levels();
 }
@@ -216,9 +390,42 @@ void Aging2Master::remove_vertices(){
     loader.load(vertices, num_vertices);
     m_results.m_num_artificial_vertices = num_vertices;
 
+    // pre-partition the vertices among the workers
+    const uint64_t num_workers = m_workers.size();
+    m_vertex_partitions.reset( new VertexPartition[num_workers] );
+    for(uint64_t i = 0; i < num_workers; i++){
+        m_vertex_partitions[i].m_next = i * num_vertices / num_workers;
+        m_vertex_partitions[i].m_end = (i +1) * num_vertices / num_workers;
+    }
+    unique_ptr<uint64_t[]> ptr_latencies;
+    if(parameters().m_measure_latency){
+        ptr_latencies.reset( new uint64_t[num_vertices]() );
+        m_latencies_remove_vertices = ptr_latencies.get();
+    }
+
+    Timer timer_removals; timer_removals.start();
     for(auto w: m_workers) w->remove_vertices(vertices, num_vertices);
     for(auto w: m_workers) w->wait();
+    utility::MemoryUsage::set_library_scope(true);
     m_parameters.m_library->build();
+    utility::MemoryUsage::set_library_scope(false);
+    timer_removals.stop();
+
+    m_results.m_remove_vertices_time = timer_removals.microseconds();
+    m_results.m_num_vertices_removed = 0;
+    m_results.m_num_vertices_stolen = 0;
+    for(auto w: m_workers){
+        m_results.m_num_vertices_removed += w->num_vertices_removed();
+        m_results.m_num_vertices_stolen += w->num_vertices_stolen();
+    }
+    LOG("[Aging2] Vertices removed: " << m_results.m_num_vertices_removed << "/" << num_vertices << " in " << timer_removals << ", "
+            "stolen by other workers: " << m_results.m_num_vertices_stolen);
+    if(m_latencies_remove_vertices != nullptr){
+        m_results.m_latency_stats_remove_vertices.reset( new LatencyStatistics{ LatencyStatistics::compute_statistics(m_latencies_remove_vertices, num_vertices) } );
+        m_latencies_remove_vertices = nullptr;
+        LOG("[Aging2] Average latency of vertex removals: " << DurationQuantity(m_results.m_latency_stats_remove_vertices->mean()) << ", 99th percentile: " << DurationQuantity(m_results.m_latency_stats_remove_vertices->percentile99()));
+    }
+    m_vertex_partitions.reset();
 
     LOG("[Aging2] Number of extra vertices: " << m_results.m_num_artificial_vertices << ", "
             "expansion factor: " << static_cast<double>(m_results.m_num_artificial_vertices +  m_results.m_num_vertices_final_graph) / m_results.m_num_vertices_final_graph);
@@ -227,12 +434,23 @@ void Aging2Master::remove_vertices(){
 }
 
 Aging2Result Aging2Master::execute(){
-    load_edges();
+    if(m_results.m_hardware_counters){ m_hardware_counters.reset( new HardwareCountersThread() ); } // it must be created & destroyed by this thread
+
+    if(parameters().m_streaming_depth == 0){ // otherwise the updates are decoded while the experiment runs
+        load_edges();
+    }
+    if(parameters().m_resume) resume();
     if(parameters().m_measure_latency) prepare_latencies();
+    record_hardware_counters("load");
     do_run_experiment();
-    remove_vertices();
+    if(parameters().m_synthetic_log.get() == nullptr) remove_vertices(); // a synthetic log does not create artificial vertices
+    record_hardware_counters("remove_vertices");
 
     store_results();
+    if(m_hardware_counters){
+        m_hardware_counters.reset();
+        m_results.m_hardware_counters->report();
+    }
     log_num_vtx_edges();
 
     return m_results;
@@ -258,14 +476,7 @@ uint64_t Aging2Master::num_edges_final_graph() const {
 }
 
 void Aging2Master::wait_and_record() {
-    chrono::seconds progress_check_interval( 1 );
-    while (true) {
-        if (m_parameters.progress_so_far() > 0.1) { // The graph reached its final size
-          break;
-        }
-        this_thread::sleep_for( progress_check_interval ) ;
-      
-    }
+    m_parameters.wait_for_progress(0, 0.1); // The graph reached its final size
 
     m_measure.store(true);
     bool done = false;
@@ -277,6 +488,8 @@ void Aging2Master::wait_and_record() {
     chrono::steady_clock::time_point now = chrono::steady_clock::now();
     chrono::steady_clock::time_point last_memory_footprint_recording = now;
     chrono::steady_clock::time_point timeout = now + ( m_parameters.m_timeout == 0s ? /* 1 month */ 31 * 24h : m_parameters.m_timeout );
+    const bool checkpoint_enabled = !parameters().m_checkpoint_path.empty();
+    chrono::steady_clock::time_point next_checkpoint = now + parameters().m_checkpoint_interval;
 
     do {
         auto tp = now + 1s;
@@ -294,11 +507,12 @@ void Aging2Master::wait_and_record() {
 
             if(measure_memfp && (/* first tick */ (m_results.m_progress.size() == 1) || tp - last_memory_footprint_recording >= 10s)){
                 uint64_t tick = m_results.m_progress.size(); // 1, 10, 20, 30, 40, 50, 60, ...
-                uint64_t memfp_process = measure_physical_memory ? common::get_memory_footprint() : max<int64_t>(utility::MemoryUsage::memory_footprint(), 0);
+                int64_t memfp_library = 0; // only available with the memory profiler
+                uint64_t memfp_process = measure_physical_memory ? common::get_memory_footprint() : max<int64_t>(utility::MemoryUsage::memory_footprint(&memfp_library), 0);
                 uint64_t memfp_driver = memory_footprint();
-                Aging2Result::MemoryFootprint memfp { tick, memfp_process, memfp_driver, /* cool off ? */ false };
+                Aging2Result::MemoryFootprint memfp { tick, memfp_process, memfp_driver, static_cast<uint64_t>(max<int64_t>(memfp_library, 0)), /* cool off ? */ false };
                 m_results.m_memory_footprint.push_back( memfp );;
-                if(report_memfp){ LOG("Memory footprint after " << DurationQuantity( tick ) << ": " << ComputerQuantity(memfp_process - memfp_driver, true)); }
+                if(report_memfp){ LOG("Memory footprint after " << DurationQuantity( tick ) << ": " << ComputerQuantity(memfp_process - memfp_driver, true) << ", library: " << ComputerQuantity(memfp.m_memory_library, true)); }
                 if(m_results.m_progress.size() > 1) { last_memory_footprint_recording = tp; } // beyond the first tick
 
                 if(parameters().m_memfp_threshold > 0 && memfp_process >= parameters().m_memfp_threshold){
@@ -313,6 +527,14 @@ void Aging2Master::wait_and_record() {
                 LOG("TIMEOUT HIT, Terminating the experiment ... ");
                 m_stop_reason = StopReason::TIMEOUT_HIT;
             }
+
+            if(checkpoint_enabled && !m_stop_experiment && now >= next_checkpoint){
+                auto t0 = chrono::steady_clock::now();
+                checkpoint();
+                now = chrono::steady_clock::now();
+                timeout += now - t0; // the time spent taking the checkpoint does not count towards the timeout
+                next_checkpoint = now + parameters().m_checkpoint_interval;
+            }
         }
     } while(!done && !m_stop_experiment);
 
@@ -330,6 +552,100 @@ void Aging2Master::wait_and_record() {
     }
 }
 
+/*****************************************************************************
+ *                                                                           *
+ * Checkpoints                                                               *
+ *                                                                           *
+ *****************************************************************************/
+void Aging2Master::resume(){
+    const string& path = parameters().m_checkpoint_path;
+    LOG("[Aging2] Resuming the experiment from the checkpoint " << path << " ...");
+    Timer timer; timer.start();
+
+    Aging2Checkpoint checkpoint = Aging2Checkpoint::load(path);
+    if(checkpoint.m_path_log != parameters().m_path_log){
+        ERROR("The checkpoint `" << path << "' refers to a different graphlog: " << checkpoint.m_path_log);
+    }
+    if(checkpoint.m_num_threads != parameters().m_num_threads){
+        ERROR("The checkpoint `" << path << "' was taken with " << checkpoint.m_num_threads << " worker threads, rather than " << parameters().m_num_threads);
+    }
+    if(checkpoint.m_reported_times.size() > m_reported_times_sz){
+        ERROR("The checkpoint `" << path << "' is corrupted, too many reported times: " << checkpoint.m_reported_times.size());
+    }
+    if(!checkpoint.m_has_snapshot || !parameters().m_library->load_snapshot(Aging2Checkpoint::snapshot_path(path))){
+        ERROR("Cannot resume the experiment, the library did not save or cannot load a snapshot of the graph");
+    }
+
+    for(uint64_t i = 0; i < m_workers.size(); i++){
+        m_workers[i]->set_resume_position(checkpoint.m_worker_positions[i]);
+    }
+    m_last_time_reported = checkpoint.m_last_time_reported;
+    copy(begin(checkpoint.m_reported_times), end(checkpoint.m_reported_times), m_reported_times);
+    m_resume_elapsed_time = checkpoint.m_elapsed_time;
+
+    timer.stop();
+    LOG("[Aging2] Experiment resumed in " << timer << ", updates already performed: " << checkpoint.m_num_operations_performed << "/" << num_operations_total());
+}
+
+void Aging2Master::checkpoint(){
+    const string& path = parameters().m_checkpoint_path;
+    COUT_DEBUG("Taking a checkpoint in " << path);
+
+    { // pause the workers at the end of their current chunk of updates
+        unique_lock<mutex> lock(m_checkpoint_mutex);
+        m_checkpoint_pause = true;
+        m_checkpoint_condvar.wait(lock, [this](){ return m_checkpoint_num_paused + m_checkpoint_num_done == m_workers.size(); });
+    }
+    Timer timer; timer.start(); // from now on, the workers are idle
+
+    Aging2Checkpoint checkpoint;
+    checkpoint.m_elapsed_time = elapsed_time();
+    checkpoint.m_path_log = parameters().m_path_log;
+    checkpoint.m_num_threads = parameters().m_num_threads;
+    checkpoint.m_num_operations_performed = num_operations_sofar();
+    checkpoint.m_last_time_reported = m_last_time_reported;
+    checkpoint.m_reported_times.assign(m_reported_times, m_reported_times + m_last_time_reported);
+    for(auto w: m_workers){ checkpoint.m_worker_positions.push_back(w->cursor()); } // not the counters, they skip the failed updates
+
+    // first the snapshot, then the checkpoint referring to it
+    string path_snapshot = Aging2Checkpoint::snapshot_path(path);
+    string path_snapshot_tmp = path_snapshot + ".tmp";
+    checkpoint.m_has_snapshot = parameters().m_library->save_snapshot(path_snapshot_tmp);
+    if(checkpoint.m_has_snapshot && ::rename(path_snapshot_tmp.c_str(), path_snapshot.c_str()) != 0){
+        ERROR("Cannot rename the snapshot `" << path_snapshot_tmp << "' into `" << path_snapshot << "'");
+    }
+    checkpoint.save(path);
+
+    { // resume the workers
+        unique_lock<mutex> lock(m_checkpoint_mutex);
+        m_checkpoint_pause = false;
+    }
+    m_checkpoint_condvar.notify_all();
+
+    timer.stop();
+    m_checkpoint_time += timer.microseconds();
+    LOG("[Aging2] Checkpoint saved in " << timer << ", updates performed: " << checkpoint.m_num_operations_performed << (checkpoint.m_has_snapshot ? "" : ", WARNING: the library does not support snapshots, the experiment cannot be resumed"));
+}
+
+void Aging2Master::checkpoint_pause_worker(){
+    unique_lock<mutex> lock(m_checkpoint_mutex);
+    m_checkpoint_num_paused++;
+    m_checkpoint_condvar.notify_all();
+    m_checkpoint_condvar.wait(lock, [this](){ return !m_checkpoint_pause; });
+    m_checkpoint_num_paused--;
+}
+
+void Aging2Master::checkpoint_worker_done(){
+    unique_lock<mutex> lock(m_checkpoint_mutex);
+    m_checkpoint_num_done++;
+    m_checkpoint_condvar.notify_all();
+}
+
+uint64_t Aging2Master::elapsed_time() const {
+    uint64_t time_sofar = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - m_time_start).count();
+    return time_sofar + m_resume_elapsed_time - m_checkpoint_time;
+}
+
 void Aging2Master::cooloff(std::chrono::steady_clock::time_point start){
     if(m_parameters.m_cooloff.count() == 0) return; // nothing to do
     const bool report_memfp = parameters().m_report_memory_footprint;
@@ -342,11 +658,12 @@ void Aging2Master::cooloff(std::chrono::steady_clock::time_point start){
     chrono::seconds next_tick { chrono::duration_cast<chrono::seconds>(now - start) +1s };
     do {
         this_thread::sleep_until(start + next_tick);
-        uint64_t memfp_process = measure_physical_memory ? common::get_memory_footprint() : max<int64_t>(utility::MemoryUsage::memory_footprint(), 0);
+        int64_t memfp_library = 0; // only available with the memory profiler
+        uint64_t memfp_process = measure_physical_memory ? common::get_memory_footprint() : max<int64_t>(utility::MemoryUsage::memory_footprint(&memfp_library), 0);
         uint64_t memfp_driver = memory_footprint();
-        Aging2Result::MemoryFootprint memfp { static_cast<uint64_t>(next_tick.count()), memfp_process, memfp_driver, /* cool off ? */ true };
+        Aging2Result::MemoryFootprint memfp { static_cast<uint64_t>(next_tick.count()), memfp_process, memfp_driver, static_cast<uint64_t>(max<int64_t>(memfp_library, 0)), /* cool off ? */ true };
         if(measure_memfp) { m_results.m_memory_footprint.push_back(memfp); }
-        if(report_memfp){ LOG("Memory footprint (cool-off) after " << DurationQuantity( (uint64_t) next_tick.count() ) << ": " << ComputerQuantity(memfp_process - memfp_driver, true) ); }
+        if(report_memfp){ LOG("Memory footprint (cool-off) after " << DurationQuantity( (uint64_t) next_tick.count() ) << ": " << ComputerQuantity(memfp_process - memfp_driver, true) << ", library: " << ComputerQuantity(memfp.m_memory_library, true) ); }
         next_tick += 1s;
 
         now = chrono::steady_clock::now();
@@ -355,6 +672,11 @@ void Aging2Master::cooloff(std::chrono::steady_clock::time_point start){
     LOG("[Aging2] Cool-off period terminated");
 }
 
+void Aging2Master::record_hardware_counters(const char* phase){
+    if(!m_hardware_counters) return; // not recorded
+    m_results.m_hardware_counters->record(phase, m_hardware_counters->sample());
+}
+
 void Aging2Master::store_results(){
     m_results.m_num_vertices_final_graph = parameters().m_library->num_vertices();
     m_results.m_num_edges_final_graph = parameters().m_library->num_edges();
@@ -363,6 +685,8 @@ void Aging2Master::store_results(){
         m_results.m_reported_times.push_back( m_reported_times[i] );
     }
 
+    store_timeline(); // before the latencies are sorted by #compute_statistics
+
     if(parameters().m_measure_latency){
         assert(m_latencies != nullptr);
         LOG("[Aging2] Computing the statistics for the measured latencies ...");
@@ -380,10 +704,150 @@ void Aging2Master::store_results(){
         delete[] m_latencies; m_latencies = nullptr; // free some memory
     }
 
+    if(parameters().m_read_ratio > 0){ // point lookups
+        for(auto w: m_workers){
+            m_results.m_num_reads += w->num_reads();
+            m_results.m_num_reads_found += w->num_reads_found();
+        }
+        LOG("[Aging2] Point lookups performed: " << m_results.m_num_reads << ", found: " << m_results.m_num_reads_found);
+
+        if(parameters().m_measure_latency){
+            LatencyHistogram latencies;
+            for(auto w: m_workers){ latencies.merge(w->latencies_reads()); }
+            m_results.m_latency_stats_reads.reset( new LatencyStatistics{ LatencyStatistics::compute_statistics(latencies) } );
+            LOG("[Aging2] Average latency of point lookups: " << DurationQuantity(m_results.m_latency_stats_reads->mean()) << ", 99th percentile: " << DurationQuantity(m_results.m_latency_stats_reads->percentile99()));
+        }
+    }
+
+    if(parameters().m_worker_granularity_target > 0us){ // adaptive granularity
+        uint64_t granularity_min = numeric_limits<uint64_t>::max(), granularity_max = 0;
+        for(auto w: m_workers){
+            m_results.m_worker_granularities.push_back( Aging2Result::WorkerGranularity{ w->num_chunks(), w->granularity_min(), w->granularity_max(), w->granularity_avg(), w->granularity_last() } );
+            granularity_min = std::min(granularity_min, w->granularity_min());
+            granularity_max = std::max(granularity_max, w->granularity_max());
+        }
+        LOG("[Aging2] Adaptive granularity, target: " << DurationQuantity(chrono::duration_cast<chrono::nanoseconds>(parameters().m_worker_granularity_target).count()) << ", "
+                "operations per chunk in [" << granularity_min << ", " << granularity_max << "]");
+    }
+
+    if(parameters().m_arrival_rate > 0){ // open loop
+        for(auto w: m_workers){ m_results.m_num_late_operations += w->num_late_operations(); }
+        LOG("[Aging2] Open loop, updates sent after their scheduled time: " << m_results.m_num_late_operations << "/" << num_operations_sofar());
+    }
     m_results.m_timeout_hit = (m_stop_reason == StopReason::TIMEOUT_HIT);
     m_results.m_memfp_threshold_passed  = (m_stop_reason == StopReason::MEMORY_FOOTPRINT);
 }
 
+/*****************************************************************************
+ *                                                                           *
+ * Timeline                                                                  *
+ *                                                                           *
+ *****************************************************************************/
+void Aging2Master::timeline_start(){
+    if(parameters().m_timeline_resolution == 0ms) return; // timeline disabled
+    assert(!m_timeline_thread.joinable() && "Timeline already started");
+    m_timeline_terminate = false;
+    m_timeline_samples.clear();
+    m_timeline_thread = thread{ &Aging2Master::main_timeline, this };
+}
+
+void Aging2Master::timeline_stop(){
+    if(!m_timeline_thread.joinable()) return; // not running
+    m_timeline_terminate = true;
+    m_timeline_thread.join();
+}
+
+void Aging2Master::main_timeline(){
+    concurrency::set_thread_name("Aging2 timeline");
+    const auto resolution = parameters().m_timeline_resolution;
+    vector<pair<uint64_t, uint64_t>> sample ( m_workers.size() );
+    auto tp = m_time_start;
+
+    do {
+        tp += resolution;
+        this_thread::sleep_until(tp);
+
+        for(uint64_t i = 0; i < m_workers.size(); i++){
+            sample[i] = make_pair(m_workers[i]->num_insertions_performed(), m_workers[i]->num_deletions_performed());
+        }
+        m_timeline_samples.push_back(sample);
+    } while(!m_timeline_terminate);
+}
+
+// Retrieve the given percentile from the array of latencies. The array is partially reordered.
+static uint64_t timeline_percentile(vector<uint64_t>& latencies, double percentile){
+    if(latencies.empty()) return 0;
+    uint64_t pos = min<uint64_t>( latencies.size() * percentile, latencies.size() -1 );
+    nth_element(begin(latencies), begin(latencies) + pos, end(latencies));
+    return latencies[pos];
+}
+
+void Aging2Master::store_timeline(){
+    if(m_timeline_samples.empty()) return; // timeline disabled
+    LOG("[Aging2] Computing the timeline of the experiment ...");
+    Timer timer; timer.start();
+
+    using namespace std::chrono;
+    const auto resolution = parameters().m_timeline_resolution;
+    const bool with_latency = m_latencies != nullptr;
+    const auto events = m_parameters.m_event_log.events();
+    vector<pair<uint64_t, uint64_t>> previous ( m_workers.size(), make_pair(0ull, 0ull) );
+    vector<uint64_t> latencies;
+
+    m_results.m_timeline.clear();
+    m_results.m_timeline.reserve(m_timeline_samples.size());
+    for(uint64_t window_id = 0; window_id < m_timeline_samples.size(); window_id++){
+        const auto& sample = m_timeline_samples[window_id];
+        Aging2Result::TimelineWindow window {};
+
+        // throughput & latency
+        latencies.clear();
+        for(uint64_t i = 0; i < m_workers.size(); i++){
+            window.m_num_insertions += sample[i].first - previous[i].first;
+            window.m_num_deletions += sample[i].second - previous[i].second;
+            if(with_latency){
+                const uint64_t* latencies_insertions = m_workers[i]->latencies_insertions();
+                const uint64_t* latencies_deletions = m_workers[i]->latencies_deletions();
+                latencies.insert(end(latencies), latencies_insertions + previous[i].first, latencies_insertions + sample[i].first);
+                latencies.insert(end(latencies), latencies_deletions + previous[i].second, latencies_deletions + sample[i].second);
+            }
+        }
+        window.m_latency_p50 = timeline_percentile(latencies, 0.5);
+        window.m_latency_p99 = timeline_percentile(latencies, 0.99);
+        window.m_latency_p999 = timeline_percentile(latencies, 0.999);
+
+        // maintenance events overlapping the window
+        steady_clock::time_point window_start = m_time_start + resolution * static_cast<int64_t>(window_id);
+        steady_clock::time_point window_end = window_start + resolution;
+        for(const auto& event : events){
+            if(event.m_end < window_start || event.m_start >= window_end) continue;
+            bool started_here = event.m_start >= window_start;
+            uint64_t overlap = duration_cast<microseconds>( min(event.m_end, window_end) - max(event.m_start, window_start) ).count();
+            switch(event.m_type){
+            case EventLog::Type::BUILD:
+                window.m_num_builds += started_here;
+                window.m_time_builds += overlap;
+                break;
+            case EventLog::Type::CREATE_EPOCH:
+                window.m_num_epochs += started_here;
+                window.m_time_epochs += overlap;
+                break;
+            case EventLog::Type::GC:
+                window.m_num_gc += started_here;
+                window.m_time_gc += overlap;
+                break;
+            }
+        }
+
+        m_results.m_timeline.push_back(window);
+        previous = sample;
+    }
+    m_timeline_samples.clear();
+
+    timer.stop();
+    LOG("[Aging2] Timeline of " << m_results.m_timeline.size() << " windows computed in " << timer);
+}
+
 void Aging2Master::log_num_vtx_edges(){
     scoped_lock<mutex> lock(_log_mutex);
     cerr << "[Aging2] Number of stored vertices: " << m_results.m_num_vertices_final_graph << " [match: ";
@@ -430,6 +894,9 @@ uint64_t Aging2Master::memory_footprint() const {
     // workers
     for(auto& w: m_workers){ result += w->memory_footprint(); }
 
+    // streaming mode, the updates decoded but not yet fetched by the workers
+    result += m_streaming_mem_usage;
+
     // size of the internal vectors
     if(parameters().m_memfp_physical){ // physical memory
         //result += sizeof(uint64_t) * static_cast<uint64_t>( m_parameters.m_num_reports_per_operations * ::ceil( static_cast<double>(num_operations_total())/num_edges_final_graph()) + 1 );
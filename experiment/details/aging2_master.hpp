@@ -17,9 +17,12 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
-#include <atomic>
 
 #include "common/static_index.hpp"
 #include "experiment/aging2_result.hpp"
@@ -29,22 +32,27 @@
 // forward declarations
 namespace gfe::experiment { class Aging2Experiment; }
 namespace gfe::experiment::details { class Aging2Worker; }
+namespace gfe::experiment::details { class HardwareCountersThread; }
+namespace gfe::experiment::details { template<typename T> class BoundedQueue; }
 namespace gfe::experiment::details { class LatencyStatistics; }
 
 namespace gfe::experiment::details {
 
 class Aging2Master {
+    friend class gfe::experiment::Aging2Experiment;
     friend class Aging2Worker;
 
     Aging2Experiment& m_parameters;
     const bool m_is_directed; // is the graph directed?
+    const bool m_filter_updates; // whether to skip a fraction of the updates from the graphlog, never for a synthetic log
     std::vector<Aging2Worker*> m_workers; // pool of workers
-    std::atomic<int64_t> m_num_operations_performed = 0; // current number of operations performed so far
+    std::atomic<uint64_t> m_num_operations_performed = 0; // updates performed by all workers so far, incremented once per chunk
     std::atomic<int> m_last_progress_reported = 0; // the last progress of the experiment, reported by any of the worker threads. E.g. 1%, 2%, 3%, so on.
 
     // report how long it took to perform 1x, 2x, 3x, ... updates w.r.t. to the loaded graph.
     std::chrono::steady_clock::time_point m_time_start; // when the computation started
     uint64_t* m_reported_times = nullptr; // microsecs
+    uint64_t m_reported_times_sz = 0; // number of entries in the array m_reported_times
     std::atomic<int> m_last_time_reported = 0;
 
     // latencies of each update
@@ -61,12 +69,44 @@ class Aging2Master {
 
     std::atomic_bool m_experiment_running = false;
 
+    // timeline of the throughput & latency, sampled by a background thread
+    std::thread m_timeline_thread; // the thread sampling the workers
+    std::atomic<bool> m_timeline_terminate = false; // signal the timeline thread to stop
+    std::vector<std::vector<std::pair<uint64_t, uint64_t>>> m_timeline_samples; // for each window, the number of insertions & deletions performed by each worker at its end
+
+    // removal of the artificial vertices, each worker first processes its own partition, then steals from the others
+    struct VertexPartition {
+        alignas(64) std::atomic<uint64_t> m_next; // the next vertex to remove in the partition
+        uint64_t m_end; // the end of the partition, excluded
+    };
+    std::unique_ptr<VertexPartition[]> m_vertex_partitions; // one partition for each worker
+    uint64_t* m_latencies_remove_vertices = nullptr; // the latency of each vertex removal, in nanosecs (nullptr => latency not measured)
+
+    // checkpoints of the progress of the experiment
+    std::mutex m_checkpoint_mutex; // sync the workers with the master while taking a checkpoint
+    std::condition_variable m_checkpoint_condvar; // wake up the master when all workers are paused, and the workers when the checkpoint is done
+    std::atomic<bool> m_checkpoint_pause = false; // request the workers to pause at the end of their current chunk of updates
+    uint64_t m_checkpoint_num_paused = 0; // number of workers currently paused, protected by m_checkpoint_mutex
+    uint64_t m_checkpoint_num_done = 0; // number of workers that already performed all their updates, protected by m_checkpoint_mutex
+    std::atomic<uint64_t> m_checkpoint_time = 0; // total time spent taking checkpoints, in microsecs
+    uint64_t m_resume_elapsed_time = 0; // when resuming from a checkpoint, the time already spent executing the updates, in microsecs
+
+    std::unique_ptr<HardwareCountersThread> m_hardware_counters; // the hardware counters of the master thread (nullptr => not recorded)
+
+    // streaming mode, the updates are decoded by a background thread just ahead of the workers
+    std::thread m_streaming_thread; // the thread decoding the log
+    std::vector<std::unique_ptr<BoundedQueue<std::vector<graph::WeightedEdge>*>>> m_streaming_queues; // the decoded updates waiting for each worker
+    std::atomic<uint64_t> m_streaming_mem_usage = 0; // the space used by the updates waiting in the queues, in bytes
+
     // Initialise the set of workers
     void init_workers();
 
     // Load & partition the edges to insert/remove in the available workers
     void load_edges();
 
+    // Generate & partition the edges from the synthetic log set in the parameters, in place of the graphlog
+    void load_edges_synthetic();
+
     // Prepare the array to record the latency of all updates
     void prepare_latencies();
 
@@ -76,9 +116,44 @@ class Aging2Master {
     // Remove the vertices that do not belong to the final graph
     void remove_vertices();
 
+    // Streaming mode, start/stop the background thread decoding the log
+    void streaming_start();
+    void streaming_stop();
+
+    // Logic of the background thread decoding the log, in streaming mode
+    void main_streaming();
+
     // Save the current results in `m_results'
     void store_results();
 
+    // Add the hardware events observed by the master thread since the last invocation to the given phase
+    void record_hardware_counters(const char* phase);
+
+    // Start/stop the background thread recording the timeline of the experiment
+    void timeline_start();
+    void timeline_stop();
+
+    // Logic of the background thread recording the timeline
+    void main_timeline();
+
+    // Compute the throughput, latency and maintenance events of each window of the timeline, save them in `m_results'
+    void store_timeline();
+
+    // Restore the progress of the experiment from the checkpoint
+    void resume();
+
+    // Pause the workers and save the progress of the experiment
+    void checkpoint();
+
+    // Invoked by the workers at the end of a chunk of updates, wait while the master is taking a checkpoint
+    void checkpoint_pause_worker();
+
+    // Invoked by the workers once they have performed all their updates
+    void checkpoint_worker_done();
+
+    // Time spent executing the updates so far, in microsecs, excluding the time spent taking the checkpoints
+    uint64_t elapsed_time() const;
+
     // Retrieve the current number of operations performed so far by the workers
     uint64_t num_operations_sofar() const;
 
@@ -109,6 +184,15 @@ public:
     // Is the graph directed?
     bool is_directed() const { return m_is_directed; }
 
+    // The worker (1-based) an update between the given vertices is assigned to, or -1 if the update is skipped
+    int worker_of(uint64_t source, uint64_t destination) const {
+        if(m_filter_updates && source % 10 == 9) return -1; // updates filtered out of the experiment
+        return static_cast<int>((source + destination) % m_workers.size()) + 1;
+    }
+
+    // Streaming mode, fetch the next block of updates for the given worker. Return nullptr when the log is over
+    std::vector<graph::WeightedEdge>* streaming_next(int worker_id);
+
     // Total number of operations to perform (insertions/deletions)
     uint64_t num_operations_total() const;
 
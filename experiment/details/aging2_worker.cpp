@@ -18,8 +18,10 @@
 
 #include "aging2_worker.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <cmath>
 #include <iostream>
 #include <mutex>
 #include <random>
@@ -35,6 +37,8 @@
 #include "utility/memory_usage.hpp"
 #include "aging2_master.hpp"
 #include "configuration.hpp"
+#include "hardware_counters.hpp"
+#include "thread_placement.hpp"
 
 using namespace common;
 using namespace std;
@@ -60,7 +64,9 @@ extern mutex _log_mutex [[maybe_unused]];
  *****************************************************************************/
 namespace gfe::experiment::details {
 
-Aging2Worker::Aging2Worker(Aging2Master& master, int worker_id) : m_master(master), m_library(m_master.parameters().m_library.get()), m_worker_id(worker_id), m_task{ TaskOp::IDLE, nullptr, 0 } {
+Aging2Worker::Aging2Worker(Aging2Master& master, int worker_id) : m_master(master), m_library(m_master.parameters().m_library.get()), m_worker_id(worker_id),
+        m_track_library_memory(m_master.parameters().m_memfp && !m_master.parameters().m_memfp_physical && utility::MemoryUsage::is_initialised()),
+        m_task{ TaskOp::IDLE, nullptr, 0 } {
     assert(m_library != nullptr);
 
     // start the background thread
@@ -156,16 +162,13 @@ bool Aging2Worker::wait(const chrono::time_point<chrono::steady_clock>& tp){
 void Aging2Worker::main_thread(){
     COUT_DEBUG("Worker started");
     concurrency::set_thread_name("Worker #" + to_string(m_worker_id));
-    if(m_worker_id<=4)
-    concurrency::pin_thread_to_cpu(m_worker_id-1);
-    else if(m_worker_id<=8)
-    concurrency::pin_thread_to_cpu(m_worker_id+3);
-    else if(m_worker_id<=12)
-    concurrency::pin_thread_to_cpu(m_worker_id+7);
-    else     concurrency::pin_thread_to_cpu(m_worker_id+11);
-    // concurrency::pin_thread_to_cpu(m_worker_id-1);
+    // pin the worker before loading the updates, so that its buffers are allocated on its local NUMA node (not in the streaming mode)
+    [[maybe_unused]] int cpu = apply_thread_placement(m_master.parameters().m_worker_placement, m_worker_id -1);
+    COUT_DEBUG("Pinned to the logical CPU: " << cpu);
     m_library->on_thread_init(m_worker_id);
-    
+    HardwareCountersLog* hardware_counters_log = m_master.m_results.m_hardware_counters.get();
+    unique_ptr<HardwareCountersThread> hardware_counters;
+    if(hardware_counters_log != nullptr){ hardware_counters.reset( new HardwareCountersThread() ); }
 
     bool terminate = false;
     Task task; // current task
@@ -191,8 +194,8 @@ void Aging2Worker::main_thread(){
             terminate = true;
             break;
         case TaskOp::SET_ARRAY_LATENCIES:
-            m_latency_insertions = task.m_payload;
-            m_latency_deletions = reinterpret_cast<uint64_t*>(task.m_payload_sz); // hack
+            m_latency_insertions = m_latency_insertions_begin = task.m_payload;
+            m_latency_deletions = m_latency_deletions_begin = reinterpret_cast<uint64_t*>(task.m_payload_sz); // hack
             break;
         case TaskOp::LOAD_EDGES:
             main_load_edges(task.m_payload, task.m_payload_sz);
@@ -204,8 +207,21 @@ void Aging2Worker::main_thread(){
             main_remove_vertices(task.m_payload, task.m_payload_sz);
             break;
         }
+
+        // attribute the events of the task to the related phase of the experiment
+        if(hardware_counters){
+            HardwareCounters sample = hardware_counters->sample();
+            switch(task.m_type){
+            case TaskOp::LOAD_EDGES: hardware_counters_log->record("load", sample); break;
+            case TaskOp::EXECUTE_UPDATES: hardware_counters_log->record("run", sample); break;
+            case TaskOp::REMOVE_VERTICES: hardware_counters_log->record("remove_vertices", sample); break;
+            default: ; /* ignore */
+            }
+        }
     } while (!terminate);
 
+    hardware_counters.reset();
+
     m_library->on_thread_destroy(m_worker_id);
 
     // not really necessary, only present for consistency ..
@@ -230,25 +246,45 @@ void Aging2Worker::main_execute_updates(){
     COUT_DEBUG("Initial memory footprint: " << m_updates_mem_usage << " bytes");
 
     const int64_t num_total_ops = m_master.num_operations_total();
+    const chrono::nanoseconds granularity_target = m_master.parameters().m_worker_granularity_target; // 0 => fixed granularity
+    m_granularity = m_granularity_min = m_granularity_max = m_master.parameters().m_worker_granularity;
     const bool report_progress = m_master.parameters().m_report_progress;
-    const bool release_memory = m_master.parameters().m_release_driver_memory;
+    const bool streaming = m_master.parameters().m_streaming_depth > 0; // fetch the updates from the master as they are decoded
+    const bool release_memory = streaming || m_master.parameters().m_release_driver_memory;
     // reports_per_ops only affects how often a report is saved in the db, not the report to the stdout
     const double reports_per_ops = m_master.parameters().m_num_reports_per_operations;
-    int lastset_coeff = 0;
     int epoch=1;
-    for(uint64_t i = 0, end = m_updates.size(); i < end; i++){
+    uint64_t num_updates_skip = m_resume_position; // updates already performed before the checkpoint
+    for(uint64_t i = 0, end = m_updates.size(); streaming || i < end; i++){
+        if(streaming){ // wait for the next block of updates
+            vector<graph::WeightedEdge>* buffer = m_master.m_stop_experiment ? nullptr : m_master.streaming_next(m_worker_id);
+            if(buffer == nullptr) break; // the log is over
+            m_updates.append(buffer);
+            if(m_master.parameters().m_memfp_physical){ // physical space
+                m_updates_mem_usage += buffer->size() * sizeof(gfe::graph::WeightedEdge);
+            } else { // virtual space
+                m_updates_mem_usage += utility::MemoryUsage::get_allocated_space(buffer->data());
+            }
+        }
+
         // if we're release the driver's memory, always fetch the first. Otherwise follow the index.
         vector<graph::WeightedEdge>* operations = m_updates[release_memory ? 0 : i];
 
-        uint64_t num_loops = (operations->size() / granularity()) + (operations->size() % granularity() != 0);
-        uint64_t start = 0;
-        for(uint64_t j = 0; j < num_loops; j++){
+        uint64_t start = std::min<uint64_t>( num_updates_skip, operations->size() );
+        num_updates_skip -= start;
+        while(start < operations->size()){
             uint64_t end = std::min( start + granularity(), operations->size() );
 
             // execute a chunk of updates
+            chrono::steady_clock::time_point chunk_start;
+            if(granularity_target > 0ns){ chunk_start = chrono::steady_clock::now(); }
             graph_execute_batch_updates(operations->data() + start, end - start);
+            if(granularity_target > 0ns){ adapt_granularity(end - start, chrono::steady_clock::now() - chunk_start, granularity_target); }
 
-            uint64_t num_ops_done = m_master.m_num_operations_performed.fetch_add( end - start );
+            // the per-worker counters are only aggregated on demand, a single shared counter tracks the exact progress. The
+            // acq_rel order makes the per-worker counters of the previous chunks visible to the threads we wake up
+            uint64_t num_ops_done = m_master.m_num_operations_performed.fetch_add(end - start, memory_order_acq_rel) + (end - start);
+            m_master.m_parameters.notify_progress(num_ops_done); // wake up the threads waiting for the progress of the experiment, if any
 
             // report progress
             if(report_progress && static_cast<int>(100.0 * num_ops_done/num_total_ops) > m_master.m_last_progress_reported){
@@ -259,15 +295,19 @@ void Aging2Worker::main_execute_updates(){
             }
 
             // report how long it took to perform 1x, 2x, ... updates w.r.t. to the size of the final graph
+            int lastset_coeff = m_master.m_last_time_reported.load(memory_order_relaxed); // != 0 when resuming from a checkpoint
             int aging_coeff = (static_cast<double>(num_ops_done) / m_master.num_edges_final_graph()) * reports_per_ops;
             if(aging_coeff > lastset_coeff){
                 if( m_master.m_last_time_reported.compare_exchange_strong(/* updates lastset_coeff */ lastset_coeff, aging_coeff) ){
-                    uint64_t duration = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - m_master.m_time_start ).count();
-                    m_master.m_reported_times[aging_coeff -1] = duration;
+                    m_master.m_reported_times[aging_coeff -1] = m_master.elapsed_time();
                 }
             }
 
+            m_cursor.store(m_cursor.load(memory_order_relaxed) + (end - start), memory_order_relaxed); // this worker is the only writer
             start = end;
+
+            // the master is taking a checkpoint
+            if(m_master.m_checkpoint_pause){ m_master.checkpoint_pause_worker(); }
         }
 
         if(release_memory){
@@ -283,6 +323,8 @@ void Aging2Worker::main_execute_updates(){
             m_updates.pop();
         }
     }
+
+    m_master.checkpoint_worker_done();
 }
 
 
@@ -291,14 +333,13 @@ void Aging2Worker::main_load_edges(uint64_t* edges, uint64_t num_edges){
     vector<graph::WeightedEdge>* last = m_updates[m_updates.size() -1];
 
     constexpr uint64_t last_max_sz = (1ull << 22); // 4M
-    const uint64_t modulo = m_master.parameters().m_num_threads;
 
     uint64_t* __restrict sources = edges;
     uint64_t* __restrict destinations = sources + num_edges;
     double* __restrict weights = reinterpret_cast<double*>(destinations + num_edges);
     uniform_real_distribution<double> rndweight{0, m_master.parameters().m_max_weight}; // in [0, max_weight)
     for(uint64_t i = 0; i < num_edges; i++){
-        if(static_cast<int>((sources[i] + destinations[i]) % modulo)+1 == m_worker_id && sources[i]%10 != 9){
+        if(m_master.worker_of(sources[i], destinations[i]) == m_worker_id){
             
             // cout<<"loading edges\n";
             if(last->size() > last_max_sz){
@@ -327,16 +368,35 @@ void Aging2Worker::main_load_edges(uint64_t* edges, uint64_t num_edges){
 }
 
 void Aging2Worker::main_remove_vertices(uint64_t* vertices, uint64_t num_vertices){
-    auto pardegree = m_master.parameters().m_num_threads;
-    m_is_in_library_code = true;
+    constexpr uint64_t batch_size = 64; // number of vertices fetched at the time from a partition
+    const uint64_t num_partitions = m_master.parameters().m_num_threads;
+    uint64_t* __restrict latencies = m_master.m_latencies_remove_vertices; // nullptr if the latency is not measured
+    set_in_library_code(true);
 
-    for(uint64_t i = 0; i < num_vertices; i++){
-          if(static_cast<int>(vertices[i] % pardegree) == m_worker_id){
-              COUT_DEBUG("Remove vertex: " << vertices[i]);
-              m_library->remove_vertex(vertices[i]);
-          }
-      }
-    m_is_in_library_code = false;
+    // first remove the vertices from the partition of this worker, then steal from the other partitions
+    for(uint64_t i = 0; i < num_partitions; i++){
+        auto& partition = m_master.m_vertex_partitions[(m_worker_id -1 + i) % num_partitions];
+
+        uint64_t start = 0;
+        while( (start = partition.m_next.fetch_add(batch_size)) < partition.m_end ){
+            uint64_t end = std::min(start + batch_size, partition.m_end);
+            if(i > 0){ m_num_vertices_stolen += end - start; }
+
+            for(uint64_t j = start; j < end; j++){
+                COUT_DEBUG("Remove vertex: " << vertices[j]);
+                if(latencies == nullptr){
+                    m_num_vertices_removed += m_library->remove_vertex(vertices[j]);
+                } else {
+                    auto t0 = chrono::steady_clock::now();
+                    m_num_vertices_removed += m_library->remove_vertex(vertices[j]);
+                    auto t1 = chrono::steady_clock::now();
+                    latencies[j] = chrono::duration_cast<chrono::nanoseconds>(t1 - t0).count();
+                }
+            }
+        }
+    }
+
+    set_in_library_code(false);
 }
 
 /*****************************************************************************
@@ -346,44 +406,198 @@ void Aging2Worker::main_remove_vertices(uint64_t* vertices, uint64_t num_vertice
  *****************************************************************************/
 
 void Aging2Worker::graph_execute_batch_updates(graph::WeightedEdge* __restrict updates, uint64_t num_updates){
+    const bool open_loop = m_master.parameters().m_arrival_rate > 0;
+
     if(m_latency_insertions == nullptr){
         assert(m_master.parameters().m_measure_latency == false);
         assert(m_latency_deletions == nullptr);
-        graph_execute_batch_updates0</* measure latency ? */ false>(updates, num_updates);
+        if(open_loop){
+            graph_execute_batch_updates0</* measure latency ? */ false, /* open loop ? */ true>(updates, num_updates);
+        } else {
+            graph_execute_batch_updates0</* measure latency ? */ false, /* open loop ? */ false>(updates, num_updates);
+        }
     } else {
         assert(m_master.parameters().m_measure_latency == true);
         assert(m_latency_deletions != nullptr);
 
-        graph_execute_batch_updates0</* measure latency ? */ true>(updates, num_updates);
+        if(open_loop){
+            graph_execute_batch_updates0</* measure latency ? */ true, /* open loop ? */ true>(updates, num_updates);
+        } else {
+            graph_execute_batch_updates0</* measure latency ? */ true, /* open loop ? */ false>(updates, num_updates);
+        }
     }
 }
 
-template<bool with_latency>
+template<bool with_latency, bool open_loop>
 void Aging2Worker::graph_execute_batch_updates0(graph::WeightedEdge* __restrict updates, uint64_t num_updates){
+    uint64_t num_insertions = 0;
+    uint64_t num_deletions = 0;
+    uint64_t num_operations = 0;
+    uint64_t num_operations_other = 0;
+
+    const uint64_t batch_size = m_master.parameters().m_update_batch_size;
+    const double read_ratio = m_master.parameters().m_read_ratio;
+
     try{
-        for(uint64_t i = 0; i < num_updates; i++){
+        if(batch_size > 1){ // send the updates in batches
+            for(uint64_t i = 0; i < num_updates && !m_master.m_stop_experiment; i += batch_size){
+                uint64_t batch_sz = min(batch_size, num_updates - i);
+                graph_update_batch<with_latency, open_loop>(updates + i, batch_sz);
+                if(read_ratio > 0){ graph_point_lookups(updates + i, batch_sz); }
+                for(uint64_t j = i; j < i + batch_sz; j++){
+                    if(updates[j].m_weight >= 0){ num_insertions++; } else { num_deletions++; }
+                }
+                if(m_master.m_measure.load(memory_order_relaxed))
+                    num_operations_other += batch_sz;
+                num_operations += batch_sz;
+            }
+        } else for(uint64_t i = 0; i < num_updates; i++){
             if(m_master.m_stop_experiment) break; // timeout, we're done
+            if(open_loop){ wait_next_arrival(); }
 
             if(updates[i].m_weight >= 0){ // insertion
-                graph_insert_edge<with_latency>(updates[i]);
-            
+                graph_insert_edge<with_latency, open_loop>(updates[i]);
+                num_insertions++;
             } else { // deletion
-                graph_remove_edge<with_latency>(updates[i].edge());
+                graph_remove_edge<with_latency, open_loop>(updates[i].edge());
+                num_deletions++;
             }
-            if(m_master.m_measure.load())
-                m_num_operations_other++;
-            m_num_operations++;
+            if(read_ratio > 0){ graph_point_lookups(updates + i, 1); }
+            if(m_master.m_measure.load(memory_order_relaxed))
+                num_operations_other++;
+            num_operations++;
         }
     }
         catch(...){
             // for(int i=0;i<num_updates;i++)
             //     cout<<updates[i].edge().source()<<" "<<updates[i].edge().destination()<<" "<<updates[i].m_weight<<endl;
         }
-    
 
+    // publish the counters for the master, this worker is the only writer
+    m_counters.m_num_operations.store(m_counters.m_num_operations.load(memory_order_relaxed) + num_operations, memory_order_relaxed);
+    m_counters.m_num_operations_other.store(m_counters.m_num_operations_other.load(memory_order_relaxed) + num_operations_other, memory_order_relaxed);
+    m_counters.m_num_insertions_performed.store(m_counters.m_num_insertions_performed.load(memory_order_relaxed) + num_insertions, memory_order_relaxed);
+    m_counters.m_num_deletions_performed.store(m_counters.m_num_deletions_performed.load(memory_order_relaxed) + num_deletions, memory_order_relaxed);
+}
+
+void Aging2Worker::graph_point_lookups(const graph::WeightedEdge* __restrict updates, uint64_t num_updates){
+    constexpr uint64_t recent_edges_capacity = 1024; // size of the ring buffer m_recent_edges
+    const double read_ratio = m_master.parameters().m_read_ratio;
+    const bool target_random = m_master.parameters().m_read_target == ReadTarget::RANDOM;
+    const bool with_latency = m_master.parameters().m_measure_latency;
+
+    // keep track of the edges recently updated
+    for(uint64_t i = 0; i < num_updates; i++){
+        if(m_recent_edges.size() < recent_edges_capacity){
+            m_recent_edges.push_back(updates[i].edge());
+        } else {
+            m_recent_edges[m_recent_edges_pos] = updates[i].edge();
+        }
+        m_recent_edges_pos = (m_recent_edges_pos +1) % recent_edges_capacity;
+    }
+
+    // reads / (reads + updates) = read_ratio => reads per update = read_ratio / (1 - read_ratio)
+    m_read_credit += num_updates * read_ratio / (1.0 - read_ratio);
+    while(m_read_credit >= 1.0){
+        m_read_credit -= 1.0;
+
+        // select the edge to look up
+        graph::Edge edge;
+        if(target_random && !m_updates.empty()){
+            const auto* operations = m_updates[ uniform_int_distribution<uint64_t>{0, m_updates.size() -1}(m_random) ];
+            if(operations->empty()) continue;
+            edge = (*operations)[ uniform_int_distribution<uint64_t>{0, operations->size() -1}(m_random) ].edge();
+        } else {
+            edge = m_recent_edges[ uniform_int_distribution<uint64_t>{0, m_recent_edges.size() -1}(m_random) ];
+        }
+        if(!m_master.is_directed() && m_uniform(m_random) < 0.5) edge.swap_src_dst(); // noise
+
+        // perform the lookup
+        chrono::steady_clock::time_point t0;
+        if(with_latency){ t0 = chrono::steady_clock::now(); }
+        set_in_library_code(true);
+        bool found = false;
+        switch(uniform_int_distribution<int>{0, 2}(m_random)){
+        case 0: found = m_library->has_edge(edge.source(), edge.destination()); break;
+        case 1: found = !isnan(m_library->get_weight(edge.source(), edge.destination())); break;
+        case 2: found = m_library->has_vertex(edge.source()); break;
+        }
+        set_in_library_code(false);
+        if(with_latency){ m_latency_reads.record( chrono::steady_clock::now() - t0 ); }
+
+        m_num_reads++;
+        m_num_reads_found += found;
+    }
+}
+
+void Aging2Worker::wait_next_arrival(){
+    const double rate = m_master.parameters().m_arrival_rate; // ops/sec
+    assert(rate > 0 && "Not in open-loop mode");
+    if(m_arrival_offset == 0){ m_arrival_start = chrono::steady_clock::now(); } // first update
+
+    m_arrival_time = m_arrival_start + chrono::nanoseconds( static_cast<int64_t>( m_arrival_offset ) );
+
+    // schedule the next update
+    double interarrival = 1e9 / rate; // nanosecs
+    if(m_master.parameters().m_arrival_process == ArrivalProcess::POISSON){
+        interarrival *= exponential_distribution<double>{1.0}(m_random);
+    }
+    m_arrival_offset += interarrival;
+
+    // wait for the scheduled time. Sleep for most of the time and spin for the last few microsecs, as the OS
+    // does not guarantee a wake up with a good enough precision
+    auto now = chrono::steady_clock::now();
+    if(now > m_arrival_time){
+        m_num_late_operations++; // the worker was busy with the previous updates
+    } else {
+        if(m_arrival_time - now > 200us){
+            this_thread::sleep_until(m_arrival_time - 100us);
+        }
+        while(chrono::steady_clock::now() < m_arrival_time) { /* spin */ };
+    }
 }
 
-template<bool with_latency>
+template<bool with_latency, bool open_loop>
+void Aging2Worker::graph_update_batch(graph::WeightedEdge* __restrict updates, uint64_t num_updates){
+    m_update_batch.clear();
+    m_update_batch_arrivals.clear();
+    for(uint64_t i = 0; i < num_updates; i++){
+        // in open-loop mode, the batch is sent when its last update is scheduled to arrive
+        if(open_loop){
+            wait_next_arrival();
+            m_update_batch_arrivals.push_back(m_arrival_time);
+        }
+
+        graph::WeightedEdge edge = updates[i];
+        if(!m_master.is_directed() && m_uniform(m_random) < 0.5) edge.swap_src_dst(); // noise
+        m_update_batch.push_back(edge);
+    }
+
+    set_in_library_code(true);
+    if(with_latency == false){
+        m_library->update_batch(m_update_batch.data(), m_update_batch.size());
+    } else { // each update of the batch is assigned the latency of the whole batch
+        chrono::steady_clock::time_point t0, t1;
+        t0 = chrono::steady_clock::now();
+        m_library->update_batch(m_update_batch.data(), m_update_batch.size());
+        t1 = chrono::steady_clock::now();
+
+        for(uint64_t i = 0; i < num_updates; i++){
+            if(open_loop){ t0 = m_update_batch_arrivals[i]; } // include the queueing time
+            uint64_t latency = chrono::duration_cast<chrono::nanoseconds>(t1 - t0).count();
+            if(m_update_batch[i].m_weight >= 0){
+                m_latency_insertions[0] = latency;
+                m_latency_insertions++;
+            } else {
+                m_latency_deletions[0] = latency;
+                m_latency_deletions++;
+            }
+        }
+    }
+    set_in_library_code(false);
+}
+
+template<bool with_latency, bool open_loop>
 void Aging2Worker::graph_insert_edge(graph::WeightedEdge edge){
 
     // if(edge.source()!=1279655 && edge.destination()!=1279655)
@@ -391,7 +605,7 @@ void Aging2Worker::graph_insert_edge(graph::WeightedEdge edge){
 
     if(!m_master.is_directed() && m_uniform(m_random) < 0.5) edge.swap_src_dst(); // noise
     COUT_DEBUG("edge: " << edge);
-     m_is_in_library_code = true;
+    set_in_library_code(true);
     if(with_latency == false){
         // the function returns true if the edge has been inserted. Repeat the loop if it cannot insert the edge as one of
         // the vertices is still being inserted by another thread
@@ -403,20 +617,21 @@ void Aging2Worker::graph_insert_edge(graph::WeightedEdge edge){
             t0 = chrono::steady_clock::now();
         } while ( ! m_library->add_edge_v2(edge) );
         t1 = chrono::steady_clock::now();
+        if(open_loop){ t0 = m_arrival_time; } // include the queueing time
 
         m_latency_insertions[0] = chrono::duration_cast<chrono::nanoseconds>(t1 - t0).count();
         m_latency_insertions++;
     }
-    m_is_in_library_code = false;
+    set_in_library_code(false);
 }
 
-template<bool with_latency>
+template<bool with_latency, bool open_loop>
 void Aging2Worker::graph_remove_edge(graph::Edge edge, bool force){
     // if(edge.source()!=1279655 && edge.destination()!=1279655)
     //     return;
     if(!m_master.is_directed() && m_uniform(m_random) < 0.5) edge.swap_src_dst(); // noise
     COUT_DEBUG("edge: " << edge);
-    m_is_in_library_code = true;
+    set_in_library_code(true);
     if(with_latency == false){
 
         if(!force){
@@ -430,7 +645,7 @@ void Aging2Worker::graph_remove_edge(graph::Edge edge, bool force){
     } else { // measure the latency of the deletion
         chrono::steady_clock::time_point t0, t1;
 
-        m_is_in_library_code = true;
+        set_in_library_code(true);
         t0 = chrono::steady_clock::now();
         if(!force){
             m_library->remove_edge(edge);
@@ -438,15 +653,67 @@ void Aging2Worker::graph_remove_edge(graph::Edge edge, bool force){
             while( ! m_library->remove_edge(edge) ) /* nop */;
         }
         t1 = chrono::steady_clock::now();
+        if(open_loop){ t0 = m_arrival_time; } // include the queueing time
 
         m_latency_deletions[0] = chrono::duration_cast<chrono::nanoseconds>(t1 - t0).count();
         m_latency_deletions++;
     }
-    m_is_in_library_code = false;
+    set_in_library_code(false);
+}
+
+void Aging2Worker::set_resume_position(uint64_t num_updates){
+    m_resume_position = num_updates;
+    m_cursor = num_updates;
+    m_counters.m_num_operations = num_updates;
+}
+
+void Aging2Worker::set_in_library_code(bool value){
+    m_counters.m_is_in_library_code.store(value, memory_order_relaxed);
+    if(m_track_library_memory){ utility::MemoryUsage::set_library_scope(value); }
 }
 
 uint64_t Aging2Worker::granularity() const{
-    return m_master.parameters().m_worker_granularity;
+    return m_granularity;
+}
+
+void Aging2Worker::adapt_granularity(uint64_t num_operations, chrono::nanoseconds elapsed, chrono::nanoseconds target){
+    constexpr uint64_t granularity_upper_bound = (1ull << 20); // 1M operations
+
+    m_num_chunks++;
+    m_num_chunks_operations += num_operations;
+
+    // Scale the granularity by the ratio between the target and the time observed for the last chunk. Shrink it at once, to remain
+    // responsive to the timeout and the checkpoints when the library slows down, but at most double it, to ignore spurious fast chunks
+    uint64_t next;
+    if(elapsed.count() <= 0){
+        next = 2 * m_granularity;
+    } else {
+        next = static_cast<uint64_t>( static_cast<double>(num_operations) * target.count() / elapsed.count() );
+        next = std::min<uint64_t>(next, 2 * m_granularity);
+    }
+    m_granularity = std::clamp<uint64_t>(next, 1, granularity_upper_bound);
+    m_granularity_min = std::min(m_granularity_min, m_granularity);
+    m_granularity_max = std::max(m_granularity_max, m_granularity);
+}
+
+uint64_t Aging2Worker::num_chunks() const {
+    return m_num_chunks;
+}
+
+uint64_t Aging2Worker::granularity_min() const {
+    return m_granularity_min;
+}
+
+uint64_t Aging2Worker::granularity_max() const {
+    return m_granularity_max;
+}
+
+uint64_t Aging2Worker::granularity_avg() const {
+    return m_num_chunks > 0 ? m_num_chunks_operations / m_num_chunks : m_granularity;
+}
+
+uint64_t Aging2Worker::granularity_last() const {
+    return m_granularity;
 }
 
 uint64_t Aging2Worker::num_insertions() const{
@@ -458,11 +725,55 @@ uint64_t Aging2Worker::num_deletions() const {
 }
 
 uint64_t Aging2Worker::num_operations() const {
-    return m_num_operations;
+    return m_counters.m_num_operations.load(memory_order_relaxed);
+}
+
+uint64_t Aging2Worker::cursor() const {
+    return m_cursor.load(memory_order_relaxed);
 }
 
 uint64_t Aging2Worker::num_operations_other() const {
-    return m_num_operations_other;
+    return m_counters.m_num_operations_other.load(memory_order_relaxed);
+}
+
+uint64_t Aging2Worker::num_reads() const {
+    return m_num_reads;
+}
+
+uint64_t Aging2Worker::num_reads_found() const {
+    return m_num_reads_found;
+}
+
+const LatencyHistogram& Aging2Worker::latencies_reads() const {
+    return m_latency_reads;
+}
+
+uint64_t Aging2Worker::num_vertices_removed() const {
+    return m_num_vertices_removed;
+}
+
+uint64_t Aging2Worker::num_vertices_stolen() const {
+    return m_num_vertices_stolen;
+}
+
+uint64_t Aging2Worker::num_late_operations() const {
+    return m_num_late_operations;
+}
+
+uint64_t Aging2Worker::num_insertions_performed() const {
+    return m_counters.m_num_insertions_performed.load(memory_order_relaxed);
+}
+
+uint64_t Aging2Worker::num_deletions_performed() const {
+    return m_counters.m_num_deletions_performed.load(memory_order_relaxed);
+}
+
+const uint64_t* Aging2Worker::latencies_insertions() const {
+    return m_latency_insertions_begin;
+}
+
+const uint64_t* Aging2Worker::latencies_deletions() const {
+    return m_latency_deletions_begin;
 }
 
 uint64_t Aging2Worker::memory_footprint() const {
@@ -470,7 +781,7 @@ uint64_t Aging2Worker::memory_footprint() const {
 }
 
 bool Aging2Worker::is_in_library_code() const {
-  return m_is_in_library_code;
+  return m_counters.m_is_in_library_code.load(memory_order_relaxed);
 }
 
 } // namespace
@@ -26,6 +26,7 @@
 
 #include "common/circular_array.hpp"
 #include "graph/edge.hpp"
+#include "latency.hpp"
 
 // forward declarations
 namespace gfe::experiment::details { class Aging2Master; }
@@ -45,12 +46,45 @@ class Aging2Worker {
     std::mt19937_64 m_random { std::random_device{}() }; // pseudo-random generator
     std::uniform_real_distribution<double> m_uniform{ 0., 1. }; // uniform distribution in [0, 1]
     uint64_t* m_latency_insertions {nullptr};
+    uint64_t* m_latency_insertions_begin {nullptr}; // the first entry of the array m_latency_insertions
     uint64_t m_num_edge_insertions {0}; // counter, total number of edge insertions to perform, as contained in the array m_updates
     uint64_t* m_latency_deletions {nullptr};
+    uint64_t* m_latency_deletions_begin {nullptr}; // the first entry of the array m_latency_deletions
     uint64_t m_num_edge_deletions {0}; // counter, total number of edge deletions to perform, as contained in the array m_updates
-    std::atomic<uint64_t> m_num_operations = 0; // counter, total number of operations performed so far
-    std::atomic<uint64_t> m_num_operations_other = 0;
-    std::atomic<bool> m_is_in_library_code = false;
+
+    // The counters sampled by the master. They are only written by this worker, after each chunk of updates, and they reside
+    // in their own cache line, so that neither the other workers nor the private fields of this worker cause false sharing.
+    struct alignas(64) Counters {
+        std::atomic<uint64_t> m_num_operations = 0; // total number of operations performed so far
+        std::atomic<uint64_t> m_num_insertions_performed = 0; // edge insertions performed so far
+        std::atomic<uint64_t> m_num_deletions_performed = 0; // edge deletions performed so far
+        std::atomic<uint64_t> m_num_operations_other = 0; // operations performed while the master requested to measure them (Aging2Master#m_measure)
+        std::atomic<bool> m_is_in_library_code = false; // whether the worker is currently executing an operation in the library
+    };
+    Counters m_counters;
+    const bool m_track_library_memory; // whether to account the allocations performed while in the library code to the memory footprint of the library
+
+    std::chrono::steady_clock::time_point m_arrival_start; // open-loop mode, the time when the worker started issuing the updates
+    double m_arrival_offset = 0; // open-loop mode, when the next update is scheduled to be sent, in nanosecs since m_arrival_start
+    std::chrono::steady_clock::time_point m_arrival_time; // open-loop mode, when the current update was scheduled to be sent
+    uint64_t m_num_late_operations = 0; // open-loop mode, number of updates sent after their scheduled time
+    double m_read_credit = 0; // number of point lookups still to perform, accrued after each update according to the read ratio
+    std::vector<gfe::graph::Edge> m_recent_edges; // ring buffer with the last edges updated by this worker, the targets of the point lookups
+    uint64_t m_recent_edges_pos = 0; // next position to overwrite in the ring buffer m_recent_edges
+    uint64_t m_num_reads = 0; // number of point lookups performed
+    uint64_t m_num_reads_found = 0; // number of point lookups that found the searched vertex/edge
+    LatencyHistogram m_latency_reads; // the latency of the point lookups, when measuring the latency. Bounded memory, regardless of the number of lookups
+    uint64_t m_num_vertices_removed = 0; // number of artificial vertices removed by this worker
+    uint64_t m_num_vertices_stolen = 0; // number of artificial vertices removed by this worker from the partitions of the other workers
+    uint64_t m_resume_position = 0; // when resuming from a checkpoint, the number of updates in m_updates already performed
+    std::atomic<uint64_t> m_cursor = 0; // position in m_updates of the next update to perform, advanced at the end of each chunk
+    uint64_t m_granularity = 0; // the number of operations in the next chunk, adapted at runtime when a target time per chunk is set
+    uint64_t m_granularity_min = 0; // adaptive granularity, the smallest granularity chosen so far
+    uint64_t m_granularity_max = 0; // adaptive granularity, the largest granularity chosen so far
+    uint64_t m_num_chunks = 0; // adaptive granularity, number of chunks executed so far
+    uint64_t m_num_chunks_operations = 0; // adaptive granularity, total number of operations in the chunks executed so far
+    std::vector<gfe::graph::WeightedEdge> m_update_batch; // the updates to send in a single invocation to #update_batch, when the batch size is > 1
+    std::vector<std::chrono::steady_clock::time_point> m_update_batch_arrivals; // open-loop mode, when each update in m_update_batch was scheduled to be sent
 
     enum class TaskOp { IDLE, START, STOP, LOAD_EDGES, EXECUTE_UPDATES, REMOVE_VERTICES, SET_ARRAY_LATENCIES };
     struct Task { TaskOp m_type; uint64_t* m_payload; uint64_t m_payload_sz; };
@@ -83,23 +117,39 @@ class Aging2Worker {
     // Execute a batch of updates
     void graph_execute_batch_updates(graph::WeightedEdge* __restrict updates, uint64_t num_updates);
 
-    template<bool with_latency>
+    template<bool with_latency, bool open_loop>
     void graph_execute_batch_updates0(graph::WeightedEdge* __restrict updates, uint64_t num_updates);
 
+    // Send the given updates to the library with a single invocation to #update_batch
+    template<bool with_latency, bool open_loop>
+    void graph_update_batch(graph::WeightedEdge* __restrict updates, uint64_t num_updates);
+
     // Insert the given edge in the graph
-    template<bool with_latency>
+    template<bool with_latency, bool open_loop>
     void graph_insert_edge(graph::WeightedEdge edge);
 
     // Remove the given edge from the graph
-    template<bool with_latency>
+    template<bool with_latency, bool open_loop>
     void graph_remove_edge(graph::Edge edge, bool force = true);
 
+    // Perform the point lookups due after the given updates, according to the read ratio
+    void graph_point_lookups(const graph::WeightedEdge* __restrict updates, uint64_t num_updates);
+
+    // Open-loop mode, wait until the next update is scheduled to be sent
+    void wait_next_arrival();
+
     // Remove the temporary edge at the head of the queue m_edges2remove
     void graph_remove_temporary_edge();
 
+    // Set whether the worker is executing the library code, to detect deadlocks and to attribute the memory footprint
+    void set_in_library_code(bool value);
+
     // The size of each burst of insertions/deletions
     uint64_t granularity() const;
 
+    // Adaptive granularity, set the size of the next chunk according to the time spent on the last one
+    void adapt_granularity(uint64_t num_operations, std::chrono::nanoseconds elapsed, std::chrono::nanoseconds target);
+
     // How many edges do we still of the final graph do we still need to insert
     int64_t missing_edges_final() const;
 
@@ -112,6 +162,9 @@ public:
     // Load a batch of edges
     void load_edges(uint64_t* edges, uint64_t num_edges);
 
+    // Resume from a checkpoint, skip the first `num_updates' of the sequence of updates assigned to this worker
+    void set_resume_position(uint64_t num_updates);
+
     // Set the latency arrays for insertions and deletions
     void set_latencies(uint64_t* array_insertions, uint64_t* array_deletions);
 
@@ -136,11 +189,46 @@ public:
     // Total number of operations performed so far
     uint64_t num_operations() const;
 
+    // The position of the next update to perform in the sequence of updates assigned to this worker. It always refers to
+    // a chunk boundary, the position to resume from when the worker is paused for a checkpoint
+    uint64_t cursor() const;
+
     uint64_t num_operations_other() const;
 
+    // Open-loop mode, number of updates sent after their scheduled time
+    uint64_t num_late_operations() const;
+
+    // Number of point lookups performed, and how many of them found the searched vertex/edge
+    uint64_t num_reads() const;
+    uint64_t num_reads_found() const;
+
+    // The latency of the point lookups performed (empty if the latency was not measured)
+    const LatencyHistogram& latencies_reads() const;
+
+    // Number of artificial vertices removed by this worker, at the end of the experiment
+    uint64_t num_vertices_removed() const;
+
+    // Number of artificial vertices this worker removed from the partitions of the other workers
+    uint64_t num_vertices_stolen() const;
+
+    // Number of edge insertions and deletions performed so far. The values are refreshed after each chunk of updates.
+    uint64_t num_insertions_performed() const;
+    uint64_t num_deletions_performed() const;
+
+    // The latencies recorded for the insertions and deletions, in the same order the updates have been performed
+    const uint64_t* latencies_insertions() const;
+    const uint64_t* latencies_deletions() const;
+
     // Rough estimate of the memory footprint consumed by this worker, in bytes
     uint64_t memory_footprint() const;
 
+    // Adaptive granularity, the number of chunks executed and the smallest, largest, average and last granularity chosen
+    uint64_t num_chunks() const;
+    uint64_t granularity_min() const;
+    uint64_t granularity_max() const;
+    uint64_t granularity_avg() const;
+    uint64_t granularity_last() const;
+
     bool is_in_library_code() const;
 };
 
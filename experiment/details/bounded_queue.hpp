@@ -0,0 +1,83 @@
+/**
+ * Copyright (C) 2019 Dean De Leo, email: dleo[at]cwi.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cinttypes>
+#include <deque>
+#include <mutex>
+
+namespace gfe::experiment::details {
+
+/**
+ * A blocking FIFO queue with a fixed capacity, to pass items from a producer to a consumer. The producer is blocked
+ * while the queue is full, and the consumer while the queue is empty. Closing the queue wakes up both sides: further
+ * insertions are rejected, while the items already in the queue can still be fetched.
+ */
+template<typename T>
+class BoundedQueue {
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    const uint64_t m_capacity; // max number of items in the queue
+    std::deque<T> m_items; // the items in the queue
+    bool m_closed = false; // whether the queue has been closed
+    std::mutex m_mutex; // sync the producer and the consumer
+    std::condition_variable m_condvar_not_empty; // wake up the consumer
+    std::condition_variable m_condvar_not_full; // wake up the producer
+
+public:
+    // Create an empty queue, with the given capacity
+    BoundedQueue(uint64_t capacity) : m_capacity(capacity > 0 ? capacity : 1) { }
+
+    // Append an item at the end of the queue, waiting until there is space available.
+    // Return false, without inserting the item, if the queue has been closed
+    bool push(T item){
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condvar_not_full.wait(lock, [this](){ return m_closed || m_items.size() < m_capacity; });
+        if(m_closed) return false;
+        m_items.push_back(std::move(item));
+        lock.unlock();
+        m_condvar_not_empty.notify_one();
+        return true;
+    }
+
+    // Remove the item at the front of the queue, waiting until one is available.
+    // Return false if the queue has been closed and there are no items left
+    bool pop(T& out){
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condvar_not_empty.wait(lock, [this](){ return m_closed || !m_items.empty(); });
+        if(m_items.empty()) return false; // closed
+        out = std::move(m_items.front());
+        m_items.pop_front();
+        lock.unlock();
+        m_condvar_not_full.notify_one();
+        return true;
+    }
+
+    // Close the queue. Both the producer and the consumer are woken up
+    void close(){
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_closed = true;
+        lock.unlock();
+        m_condvar_not_empty.notify_all();
+        m_condvar_not_full.notify_all();
+    }
+};
+
+} // namespace
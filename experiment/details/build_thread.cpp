@@ -21,6 +21,8 @@
 #include "common/quantity.hpp" // for debugging purposes
 #include "common/system.hpp"
 #include "library/interface.hpp"
+#include "utility/memory_usage.hpp"
+#include "event_log.hpp"
 
 using namespace std;
 
@@ -45,8 +47,8 @@ namespace gfe { extern mutex _log_mutex [[maybe_unused]]; }
  *****************************************************************************/
 namespace gfe::experiment::details {
 
-BuildThread::BuildThread(std::shared_ptr<gfe::library::UpdateInterface> interface, int thread_id, std::chrono::milliseconds frequency) :
-    m_interface(interface), m_thread_id(thread_id), m_frequency(frequency){
+BuildThread::BuildThread(std::shared_ptr<gfe::library::UpdateInterface> interface, int thread_id, std::chrono::milliseconds frequency, EventLog* event_log) :
+    m_interface(interface), m_thread_id(thread_id), m_frequency(frequency), m_event_log(event_log){
     m_terminate = true; // reset by the background thread
     if(m_frequency > 0ms){ // otherwise, never invoke #build()
         start();
@@ -101,7 +103,11 @@ void BuildThread::main_thread(){
 
         // no need to hold the lock here
         COUT_DEBUG("#build, num invocations: " << m_num_invocations << ", terminate: " << boolalpha << terminate);
+        auto t0 = chrono::steady_clock::now();
+        utility::MemoryUsage::set_library_scope(true); // account the allocations to the library
         m_interface->build();
+        utility::MemoryUsage::set_library_scope(false);
+        if(m_event_log != nullptr){ m_event_log->record(EventLog::Type::BUILD, t0, chrono::steady_clock::now()); }
         m_num_invocations++;
     } while(!terminate);
 
@@ -24,6 +24,7 @@
 #include <mutex>
 #include <thread>
 
+namespace gfe::experiment::details { class EventLog; } // forward decl.
 namespace gfe::library { class UpdateInterface; } // forward decl.
 
 namespace gfe::experiment::details {
@@ -42,6 +43,7 @@ class BuildThread {
     const int m_thread_id; // the internal thread_id to use with #on_thread_init and #on_thread_exit
     const std::chrono::milliseconds m_frequency; // how frequently the service shall invoke #build()
     std::atomic<uint64_t> m_num_invocations = 0; // the total number of calls to #build() by the service, so far
+    EventLog* m_event_log; // if not null, record the time spent in each invocation to #build()
 
     bool m_terminate = false; // signal the background thread that 1) has started and 2) has terminated
     std::mutex m_mutex; // sync to start/terminate the service
@@ -60,8 +62,9 @@ public:
      * @param interface the library where to invoke the method #build
      * @param thread_id the thread_id passed to the library and used by the service/background thread
      * @param frequency how frequently the method #build() shall be invoked
+     * @param event_log if not null, register each invocation to #build() in the given log
      */
-    BuildThread(std::shared_ptr<gfe::library::UpdateInterface> interface, int thread_id, std::chrono::milliseconds frequency);
+    BuildThread(std::shared_ptr<gfe::library::UpdateInterface> interface, int thread_id, std::chrono::milliseconds frequency, EventLog* event_log = nullptr);
 
     /**
      * Destructor. It implicitly stops the service.
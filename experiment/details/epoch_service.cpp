@@ -0,0 +1,266 @@
+/**
+ * Copyright (C) 2019 Dean De Leo, email: dleo[at]cwi.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "epoch_service.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <iostream>
+
+#include "common/database.hpp"
+#include "common/error.hpp"
+#include "common/quantity.hpp" // for debugging purposes
+#include "common/system.hpp"
+#include "library/interface.hpp" // GCResult
+#include "event_log.hpp"
+
+using namespace std;
+
+/*****************************************************************************
+ *                                                                           *
+ * Debug                                                                     *
+ *                                                                           *
+ *****************************************************************************/
+//#define DEBUG
+namespace gfe { extern mutex _log_mutex [[maybe_unused]]; }
+#define COUT_DEBUG_FORCE(msg) { std::scoped_lock<std::mutex> lock{::gfe::_log_mutex}; std::cout << "[EpochService::" << __FUNCTION__ << "] " << msg << std::endl; }
+#if defined(DEBUG)
+    #define COUT_DEBUG(msg) COUT_DEBUG_FORCE(msg)
+#else
+    #define COUT_DEBUG(msg)
+#endif
+
+namespace gfe::experiment::details {
+
+/*****************************************************************************
+ *                                                                           *
+ * GC policy                                                                 *
+ *                                                                           *
+ *****************************************************************************/
+GCPolicy parse_gc_policy(const std::string& value){
+    string v = value;
+    transform(begin(v), end(v), begin(v), ::tolower);
+    if(v == "none"){
+        return GCPolicy::NONE;
+    } else if (v == "periodic"){
+        return GCPolicy::PERIODIC;
+    } else if (v == "after_epoch"){
+        return GCPolicy::AFTER_EPOCH;
+    } else {
+        ERROR("Invalid GC policy: `" << value << "'. Expected either none, periodic or after_epoch");
+    }
+}
+
+const char* gc_policy_to_string(GCPolicy policy){
+    switch(policy){
+    case GCPolicy::NONE: return "none";
+    case GCPolicy::PERIODIC: return "periodic";
+    case GCPolicy::AFTER_EPOCH: return "after_epoch";
+    default: ERROR("Invalid GC policy: " << (int) policy);
+    }
+}
+
+/*****************************************************************************
+ *                                                                           *
+ * Statistics                                                                *
+ *                                                                           *
+ *****************************************************************************/
+void EpochStatistics::save(common::Database* handle) const {
+    assert(handle != nullptr);
+
+    for(const auto& epoch : m_epochs){
+        auto db = handle->add("epochs");
+        db.add("epoch", epoch.m_epoch);
+        db.add("time_created", epoch.m_time_created); // millisecs
+        db.add("time_create", epoch.m_time_create); // microsecs
+        db.add("num_pins", epoch.m_num_pins);
+        db.add("num_updates", epoch.m_num_operations); // updates performed by the writers when the epoch was created
+    }
+
+    for(const auto& pause : m_gc_pauses){
+        auto db = handle->add("gc_pauses");
+        db.add("time_start", pause.m_time_start); // millisecs
+        db.add("duration", pause.m_duration); // microsecs
+        db.add("reclaimed_bytes", pause.m_reclaimed_bytes);
+        db.add("remaining", pause.m_remaining);
+    }
+
+    auto db = handle->add("epoch_service");
+    db.add("num_epochs", (uint64_t) m_epochs.size());
+    db.add("num_gc", m_num_gc);
+    db.add("gc_time", m_time_gc); // microsecs
+    db.add("gc_max_pause", m_max_pause_gc); // microsecs
+    db.add("gc_reclaimed_bytes", m_reclaimed_bytes);
+}
+
+/*****************************************************************************
+ *                                                                           *
+ * EpochService impl                                                         *
+ *                                                                           *
+ *****************************************************************************/
+EpochService::EpochService(std::shared_ptr<gfe::library::UpdateInterface> interface, int thread_id, std::chrono::milliseconds epoch_frequency,
+        std::chrono::milliseconds gc_frequency, GCPolicy gc_policy, std::chrono::microseconds gc_budget, EventLog* event_log,
+        std::function<uint64_t()> progress) :
+    m_interface(interface), m_thread_id(thread_id), m_epoch_frequency(epoch_frequency), m_gc_frequency(gc_frequency), m_gc_budget(gc_budget), m_gc_policy(gc_policy),
+    m_event_log(event_log), m_progress(move(progress)), m_time_start(chrono::steady_clock::now()), m_current_epoch(0) {
+    if(m_gc_policy == GCPolicy::PERIODIC && m_gc_frequency == 0ms){ INVALID_ARGUMENT("The GC policy periodic requires a frequency > 0"); }
+
+    create_epoch(); // the first epoch
+
+    m_terminate = true; // reset by the background thread
+    if(m_epoch_frequency > 0ms || m_gc_policy == GCPolicy::PERIODIC){ // otherwise, there is nothing to do in background
+        start();
+    }
+}
+
+void EpochService::start(){
+    COUT_DEBUG("waiting for the service to start...");
+    m_thread = thread{ &EpochService::main_thread, this };
+
+    unique_lock<mutex> lock(m_mutex);
+    m_condvar.wait(lock, [this](){ return !m_terminate; });
+    COUT_DEBUG("ack started");
+}
+
+EpochService::~EpochService(){
+    stop();
+}
+
+void EpochService::stop(){
+    // m_mutex cannot be held while joining the background thread, as the thread needs it to observe m_terminate
+    scoped_lock<mutex> lock_stop(m_mutex_stop);
+    if(!m_thread.joinable()) return; // already stopped
+
+    COUT_DEBUG("waiting for the service to stop...");
+    unique_lock<mutex> lock(m_mutex);
+    m_terminate = true;
+    lock.unlock();
+    m_condvar.notify_all();
+    m_thread.join();
+    COUT_DEBUG("ack terminated");
+}
+
+static atomic<uint64_t> g_next_epoch { 100 }; // the id of the next epoch to create, shared by all services
+
+uint64_t EpochService::create_epoch(gfe::library::UpdateInterface* interface){
+    const uint64_t epoch = g_next_epoch++;
+    interface->create_epoch(epoch);
+    return epoch;
+}
+
+uint64_t EpochService::create_epoch(){
+    scoped_lock<mutex> lock(m_mutex_epoch);
+    const uint64_t epoch = g_next_epoch++;
+    const uint64_t num_operations = m_progress ? m_progress() : 0; // updates completed before the snapshot is taken
+
+    auto t0 = chrono::steady_clock::now();
+    m_interface->create_epoch(epoch);
+    auto t1 = chrono::steady_clock::now();
+    if(m_event_log != nullptr){ m_event_log->record(EventLog::Type::CREATE_EPOCH, t0, t1); }
+
+    m_stats.m_epochs.push_back(EpochStatistics::Epoch{ epoch,
+        static_cast<uint64_t>( chrono::duration_cast<chrono::milliseconds>(t0 - m_time_start).count() ),
+        static_cast<uint64_t>( chrono::duration_cast<chrono::microseconds>(t1 - t0).count() ),
+        0, num_operations });
+    m_current_epoch = epoch;
+    COUT_DEBUG("epoch: " << epoch << ", time: " << common::DurationQuantity(t1 - t0));
+
+    return epoch;
+}
+
+void EpochService::run_gc(){
+    auto t0 = chrono::steady_clock::now();
+    library::GCResult result = m_interface->run_gc(m_gc_budget);
+    auto t1 = chrono::steady_clock::now();
+    if(result.m_gc_end != chrono::steady_clock::time_point{}){ // only time the library's GC, without its accounting
+        t0 = result.m_gc_start;
+        t1 = result.m_gc_end;
+    }
+    if(m_event_log != nullptr){ m_event_log->record(EventLog::Type::GC, t0, t1); }
+
+    uint64_t duration = chrono::duration_cast<chrono::microseconds>(t1 - t0).count();
+    scoped_lock<mutex> lock(m_mutex_epoch);
+    m_stats.m_gc_pauses.push_back(EpochStatistics::GCPause{
+        static_cast<uint64_t>( chrono::duration_cast<chrono::milliseconds>(t0 - m_time_start).count() ), duration, result.m_reclaimed_bytes, result.m_remaining });
+    m_stats.m_num_gc++;
+    m_stats.m_time_gc += duration;
+    m_stats.m_max_pause_gc = max(m_stats.m_max_pause_gc, duration);
+    m_stats.m_reclaimed_bytes += result.m_reclaimed_bytes;
+}
+
+EpochStatistics::Epoch EpochService::pin(){
+    scoped_lock<mutex> lock(m_mutex_epoch);
+    assert(!m_stats.m_epochs.empty() && "The first epoch is created by the constructor");
+    auto& epoch = m_stats.m_epochs.back();
+    epoch.m_num_pins++;
+    m_interface->pin_epoch(epoch.m_epoch);
+    return epoch;
+}
+
+void EpochService::unpin(uint64_t epoch){
+    m_interface->unpin_epoch(epoch);
+}
+
+EpochStatistics EpochService::statistics() const {
+    scoped_lock<mutex> lock(m_mutex_epoch);
+    return m_stats;
+}
+
+void EpochService::main_thread(){
+    COUT_DEBUG("service started, thread_id: " << m_thread_id << ", epoch frequency: " << common::DurationQuantity(m_epoch_frequency) << ", "
+            "gc policy: " << gc_policy_to_string(m_gc_policy) << ", gc budget: " << common::DurationQuantity(m_gc_budget));
+    common::concurrency::set_thread_name("epoch service");
+
+    unique_lock<mutex> lock(m_mutex);
+    m_terminate = false;
+    lock.unlock();
+    m_condvar.notify_all();
+
+    if(m_thread_id >= 0){ m_interface->on_thread_init(m_thread_id); }
+
+    constexpr auto never = chrono::steady_clock::time_point::max();
+    auto next_epoch = m_epoch_frequency > 0ms ? chrono::steady_clock::now() + m_epoch_frequency : never;
+    auto next_gc = m_gc_policy == GCPolicy::PERIODIC ? chrono::steady_clock::now() + m_gc_frequency : never;
+
+    while(true){
+        lock.lock();
+        m_condvar.wait_until(lock, min(next_epoch, next_gc), [this](){ return m_terminate; });
+        bool terminate = m_terminate;
+        lock.unlock();
+        if(terminate) break;
+
+        // no need to hold the lock here
+        auto now = chrono::steady_clock::now();
+        if(now >= next_epoch){
+            create_epoch();
+            if(m_gc_policy == GCPolicy::AFTER_EPOCH){ run_gc(); }
+            next_epoch += m_epoch_frequency;
+        }
+        if(now >= next_gc){
+            run_gc();
+            next_gc = chrono::steady_clock::now() + m_gc_frequency;
+        }
+    }
+
+    if(m_thread_id >= 0){ m_interface->on_thread_destroy(m_thread_id); }
+
+    COUT_DEBUG("service terminated");
+}
+
+} // namespace
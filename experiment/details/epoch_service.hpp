@@ -0,0 +1,188 @@
+/**
+ * Copyright (C) 2019 Dean De Leo, email: dleo[at]cwi.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace common { class Database; } // forward decl.
+namespace gfe::experiment::details { class EventLog; } // forward decl.
+namespace gfe::library { class UpdateInterface; } // forward decl.
+
+namespace gfe::experiment::details {
+
+/**
+ * When the epoch service invokes the garbage collector of the library
+ */
+enum class GCPolicy {
+    NONE, // never invoke the garbage collector
+    PERIODIC, // invoke the garbage collector with a fixed frequency
+    AFTER_EPOCH // invoke the garbage collector right after the creation of each new epoch
+};
+
+/**
+ * Parse the GC policy from its string representation: none, periodic or after_epoch
+ */
+GCPolicy parse_gc_policy(const std::string& value);
+
+/**
+ * Get the string representation of the given GC policy
+ */
+const char* gc_policy_to_string(GCPolicy policy);
+
+/**
+ * The statistics gathered by the epoch service
+ */
+struct EpochStatistics {
+    struct Epoch {
+        uint64_t m_epoch; // the epoch id
+        uint64_t m_time_created; // when the epoch was created, in millisecs since the start of the service
+        uint64_t m_time_create; // the time spent in #create_epoch, in microsecs
+        uint64_t m_num_pins; // number of readers that pinned this epoch
+        uint64_t m_num_operations; // number of updates performed by the writers when the epoch was created
+    };
+    struct GCPause {
+        uint64_t m_time_start; // when the invocation started, in millisecs since the start of the service
+        uint64_t m_duration; // the length of the pause, in microsecs
+        uint64_t m_reclaimed_bytes; // the memory reclaimed, as reported by the library
+        uint64_t m_remaining; // the garbage left after the invocation, as reported by the library
+    };
+    std::vector<Epoch> m_epochs; // all epochs created by the service
+    std::vector<GCPause> m_gc_pauses; // all invocations to the garbage collector
+    uint64_t m_num_gc = 0; // number of invocations to the garbage collector
+    uint64_t m_time_gc = 0; // total time spent in the garbage collector, in microsecs
+    uint64_t m_max_pause_gc = 0; // the longest invocation to the garbage collector, in microsecs
+    uint64_t m_reclaimed_bytes = 0; // total amount of memory reclaimed by the garbage collector, in bytes
+
+    // Save the statistics in the tables epochs, gc_pauses and epoch_service
+    void save(common::Database* handle) const;
+};
+
+/**
+ * This service creates a new epoch in the library every tot millisecs and invokes its garbage collector according to
+ * the given policy. Readers can pin the latest epoch, to run on a consistent snapshot while the writers proceed.
+ * On libraries without epochs, the invocations to #create_epoch and #run_gc are nops. The pins are advisory, see
+ * Interface#pin_epoch: the service always records the epoch pinned by each reader, but whether the reader
+ * actually observes that snapshot depends on the library.
+ */
+class EpochService {
+    EpochService(const EpochService&) = delete;
+    EpochService& operator=(const EpochService&) = delete;
+
+    std::shared_ptr<gfe::library::UpdateInterface> m_interface; // the library where to create the epochs
+    const int m_thread_id; // the internal thread_id to use with #on_thread_init and #on_thread_exit, -1 to not register the service
+    const std::chrono::milliseconds m_epoch_frequency; // how frequently to create a new epoch (0 = only on demand)
+    const std::chrono::milliseconds m_gc_frequency; // how frequently to invoke the garbage collector, with the policy periodic
+    const std::chrono::microseconds m_gc_budget; // hint for the max time of each invocation to the garbage collector, 0 = unbounded
+    const GCPolicy m_gc_policy; // when to invoke the garbage collector
+    EventLog* m_event_log; // if not null, record each new epoch and each invocation to the garbage collector
+    const std::function<uint64_t()> m_progress; // if set, retrieve the number of updates performed so far by the writers
+    const std::chrono::steady_clock::time_point m_time_start; // when the service was created
+
+    mutable std::mutex m_mutex_epoch; // sync the creation of the epochs & the pins
+    std::atomic<uint64_t> m_current_epoch; // the last epoch created
+    EpochStatistics m_stats; // the statistics gathered so far, protected by m_mutex_epoch
+
+    bool m_terminate = false; // signal the background thread that 1) has started and 2) has terminated
+    std::mutex m_mutex; // sync to start/terminate the service
+    std::mutex m_mutex_stop; // serialise the invocations to #stop
+    std::condition_variable m_condvar; // as above
+    std::thread m_thread; // the handle for the thread used by the background service
+
+    // start the service, that is the background thread
+    void start();
+
+    // the actual logic of the background thread
+    void main_thread();
+
+    // invoke the garbage collector of the library and record the pause
+    void run_gc();
+
+public:
+    /**
+     * Constructor. It creates the first epoch and starts the background thread.
+     * @param interface the library where to create the epochs
+     * @param thread_id the thread_id passed to the library by the background thread, or -1 to not register the thread
+     * @param epoch_frequency how frequently to create a new epoch (0 = only on demand, with #create_epoch)
+     * @param gc_frequency how frequently to invoke the garbage collector with the policy periodic
+     * @param gc_policy when to invoke the garbage collector
+     * @param gc_budget hint for the max amount of time of each invocation to the garbage collector (0 = unbounded), see
+     *        Interface#run_gc(budget). The garbage left by an invocation is reclaimed at the next scheduled invocation
+     * @param event_log if not null, register each new epoch and each invocation to the garbage collector in the given log
+     * @param progress if set, invoked at the creation of each epoch to record the number of updates performed so far
+     */
+    EpochService(std::shared_ptr<gfe::library::UpdateInterface> interface, int thread_id, std::chrono::milliseconds epoch_frequency,
+            std::chrono::milliseconds gc_frequency, GCPolicy gc_policy, std::chrono::microseconds gc_budget, EventLog* event_log = nullptr,
+            std::function<uint64_t()> progress = nullptr);
+
+    /**
+     * Destructor. It implicitly stops the service.
+     */
+    ~EpochService();
+
+    /**
+     * Stop the service, that is, the background thread. It can be invoked multiple times and by multiple threads, all
+     * invocations return once the background thread has terminated.
+     */
+    void stop();
+
+    /**
+     * Create a new epoch now
+     * @return the id of the new epoch
+     */
+    uint64_t create_epoch();
+
+    /**
+     * Create a new epoch in the given library, outside of a service. All epochs, by any service or by this method, take
+     * their id from the same counter of the process, hence they are always increasing
+     * @return the id of the new epoch
+     */
+    static uint64_t create_epoch(gfe::library::UpdateInterface* interface);
+
+    /**
+     * Pin the latest epoch for the current reader, so that its computation runs on a consistent snapshot. The pin is
+     * advisory, it is only honoured by the libraries implementing Interface#pin_epoch.
+     * @return the epoch pinned, pass its id to #unpin
+     */
+    EpochStatistics::Epoch pin();
+
+    /**
+     * Release an epoch pinned with #pin
+     */
+    void unpin(uint64_t epoch);
+
+    /**
+     * Retrieve the last epoch created
+     */
+    uint64_t current_epoch() const { return m_current_epoch; }
+
+    /**
+     * Retrieve a copy of the statistics gathered so far
+     */
+    EpochStatistics statistics() const;
+};
+
+} // namespace
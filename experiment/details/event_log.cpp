@@ -0,0 +1,54 @@
+/**
+ * Copyright (C) 2019 Dean De Leo, email: dleo[at]cwi.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "event_log.hpp"
+
+#include "common/error.hpp"
+
+using namespace std;
+
+namespace gfe::experiment::details {
+
+EventLog::EventLog() {
+
+}
+
+void EventLog::record(Type type, clock::time_point start, clock::time_point end){
+    scoped_lock<mutex> lock(m_mutex);
+    m_events.push_back(Event{ type, start, end });
+}
+
+vector<EventLog::Event> EventLog::events() const {
+    scoped_lock<mutex> lock(m_mutex);
+    return m_events;
+}
+
+void EventLog::clear(){
+    scoped_lock<mutex> lock(m_mutex);
+    m_events.clear();
+}
+
+const char* EventLog::to_string(Type type){
+    switch(type){
+    case Type::BUILD: return "build";
+    case Type::CREATE_EPOCH: return "create_epoch";
+    case Type::GC: return "gc";
+    default: ERROR("Invalid type: " << (int) type);
+    }
+}
+
+} // namespace
@@ -0,0 +1,68 @@
+/**
+ * Copyright (C) 2019 Dean De Leo, email: dleo[at]cwi.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+namespace gfe::experiment::details {
+
+/**
+ * Thread-safe register of the maintenance events (builds, epochs, garbage collection) occurred during an experiment.
+ * The events are later matched against the windows of the timeline, to explain the spikes in the throughput/latency.
+ */
+class EventLog {
+    EventLog(const EventLog&) = delete;
+    EventLog& operator=(const EventLog&) = delete;
+
+public:
+    using clock = std::chrono::steady_clock;
+
+    // The kind of events recorded
+    enum class Type { BUILD, CREATE_EPOCH, GC };
+
+    // A single event
+    struct Event {
+        Type m_type; // the kind of event
+        clock::time_point m_start; // when the event started
+        clock::time_point m_end; // when the event terminated
+    };
+
+private:
+    mutable std::mutex m_mutex; // sync the access to m_events
+    std::vector<Event> m_events; // the events recorded so far
+
+public:
+    // Create an empty log
+    EventLog();
+
+    // Record a new event
+    void record(Type type, clock::time_point start, clock::time_point end);
+
+    // Retrieve a copy of the events recorded so far
+    std::vector<Event> events() const;
+
+    // Remove all events recorded so far
+    void clear();
+
+    // String representation of the event type
+    static const char* to_string(Type type);
+};
+
+} // namespace
@@ -0,0 +1,212 @@
+/**
+ * Copyright (C) 2019 Dean De Leo, email: dleo[at]cwi.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "hardware_counters.hpp"
+
+#include <cassert>
+#include <mutex>
+#if defined(HAVE_LIBPAPI)
+#include <cstring>
+#include <papi.h>
+#include <pthread.h>
+#endif
+
+#include "common/database.hpp"
+#include "common/error.hpp"
+#include "configuration.hpp"
+
+using namespace std;
+
+namespace gfe::experiment::details {
+
+/*****************************************************************************
+ *                                                                           *
+ *  HardwareCounters                                                         *
+ *                                                                           *
+ *****************************************************************************/
+
+HardwareCounters& HardwareCounters::operator+=(const HardwareCounters& other){
+    m_cycles += other.m_cycles;
+    m_instructions += other.m_instructions;
+    m_llc_misses += other.m_llc_misses;
+    m_dtlb_misses += other.m_dtlb_misses;
+    m_branch_misses += other.m_branch_misses;
+    return *this;
+}
+
+HardwareCounters HardwareCounters::operator-(const HardwareCounters& other) const {
+    HardwareCounters result;
+    result.m_cycles = m_cycles - other.m_cycles;
+    result.m_instructions = m_instructions - other.m_instructions;
+    result.m_llc_misses = m_llc_misses - other.m_llc_misses;
+    result.m_dtlb_misses = m_dtlb_misses - other.m_dtlb_misses;
+    result.m_branch_misses = m_branch_misses - other.m_branch_misses;
+    return result;
+}
+
+/*****************************************************************************
+ *                                                                           *
+ *  HardwareCountersThread                                                   *
+ *                                                                           *
+ *****************************************************************************/
+
+#if defined(HAVE_LIBPAPI)
+static constexpr int NUM_EVENTS = 5;
+static const int g_events[NUM_EVENTS] = { PAPI_TOT_CYC, PAPI_TOT_INS, PAPI_L3_TCM, PAPI_TLB_DM, PAPI_BR_MSP }; // same order of the fields in HardwareCounters
+static const char* g_event_names[NUM_EVENTS] = { "cycles", "instructions", "LLC misses", "dTLB misses", "branch misses" };
+
+// Initialise libpapi, only once per process
+static void papi_init(){
+    static once_flag flag;
+    call_once(flag, [](){
+        int rc = PAPI_library_init(PAPI_VER_CURRENT);
+        if(rc != PAPI_VER_CURRENT){ ERROR("[HardwareCounters] Cannot initialise libpapi, rc: " << rc); }
+        rc = PAPI_thread_init( (unsigned long (*)(void)) pthread_self );
+        if(rc != PAPI_OK){ ERROR("[HardwareCounters] Cannot initialise the thread support in libpapi: " << PAPI_strerror(rc)); }
+    });
+}
+#endif
+
+HardwareCountersThread::HardwareCountersThread(bool inherit) : m_event_set(-1), m_available{false, false, false, false, false} {
+#if defined(HAVE_LIBPAPI)
+    papi_init();
+
+    int rc = PAPI_register_thread();
+    if(rc != PAPI_OK){ ERROR("[HardwareCounters] Cannot register the thread in libpapi: " << PAPI_strerror(rc)); }
+    m_event_set = PAPI_NULL;
+    rc = PAPI_create_eventset(&m_event_set);
+    if(rc != PAPI_OK){ ERROR("[HardwareCounters] Cannot create the event set: " << PAPI_strerror(rc)); }
+
+    if(inherit){ // the event set needs to be bound to the CPU component before setting the option
+        PAPI_option_t option;
+        memset(&option, 0, sizeof(option));
+        option.inherit.eventset = m_event_set;
+        option.inherit.inherit = PAPI_INHERIT_ALL;
+        if(PAPI_assign_eventset_component(m_event_set, 0) != PAPI_OK || PAPI_set_opt(PAPI_INHERIT, &option) != PAPI_OK){
+            static once_flag flag;
+            call_once(flag, [](){ LOG("[HardwareCounters] Warning: cannot count the events of the child threads, only the calling thread is measured"); });
+        }
+    }
+
+    // not all events are available on all architectures, skip those that cannot be counted
+    for(int i = 0; i < NUM_EVENTS; i++){
+        m_available[i] = (PAPI_add_event(m_event_set, g_events[i]) == PAPI_OK);
+        if(!m_available[i]){
+            static once_flag flags[NUM_EVENTS];
+            call_once(flags[i], [i](){ LOG("[HardwareCounters] Warning: the event `" << g_event_names[i] << "' is not available, it will be reported as 0"); });
+        }
+    }
+
+    rc = PAPI_start(m_event_set);
+    if(rc != PAPI_OK){ ERROR("[HardwareCounters] Cannot start the counters: " << PAPI_strerror(rc)); }
+#endif
+}
+
+HardwareCountersThread::~HardwareCountersThread(){
+#if defined(HAVE_LIBPAPI)
+    long long values[NUM_EVENTS];
+    PAPI_stop(m_event_set, values);
+    PAPI_cleanup_eventset(m_event_set);
+    PAPI_destroy_eventset(&m_event_set);
+    PAPI_unregister_thread();
+#endif
+}
+
+HardwareCounters HardwareCountersThread::read(){
+    HardwareCounters result;
+#if defined(HAVE_LIBPAPI)
+    long long values[NUM_EVENTS];
+    int rc = PAPI_read(m_event_set, values);
+    if(rc != PAPI_OK){ ERROR("[HardwareCounters] Cannot read the counters: " << PAPI_strerror(rc)); }
+
+    // the values are stored in the same order the events were added to the event set
+    int64_t* fields[NUM_EVENTS] = { &result.m_cycles, &result.m_instructions, &result.m_llc_misses, &result.m_dtlb_misses, &result.m_branch_misses };
+    for(int i = 0, j = 0; i < NUM_EVENTS; i++){
+        if(m_available[i]){ *(fields[i]) = values[j++]; }
+    }
+#endif
+    return result;
+}
+
+HardwareCounters HardwareCountersThread::sample(){
+    HardwareCounters current = read();
+    HardwareCounters result = current - m_last_sample;
+    m_last_sample = current;
+    return result;
+}
+
+bool HardwareCountersThread::is_supported(){
+#if defined(HAVE_LIBPAPI)
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*****************************************************************************
+ *                                                                           *
+ *  HardwareCountersLog                                                      *
+ *                                                                           *
+ *****************************************************************************/
+
+HardwareCountersLog::HardwareCountersLog(const string& experiment) : m_experiment(experiment) {
+
+}
+
+void HardwareCountersLog::record(const string& phase, const HardwareCounters& sample){
+    scoped_lock<mutex> lock(m_mutex);
+    auto& entry = m_phases[phase];
+    entry.m_counters += sample;
+    entry.m_num_samples++;
+}
+
+HardwareCounters HardwareCountersLog::get(const string& phase) const {
+    scoped_lock<mutex> lock(m_mutex);
+    auto it = m_phases.find(phase);
+    return it != m_phases.end() ? it->second.m_counters : HardwareCounters{};
+}
+
+void HardwareCountersLog::report() const {
+    scoped_lock<mutex> lock(m_mutex);
+    for(const auto& p : m_phases){
+        const HardwareCounters& c = p.second.m_counters;
+        LOG("[HardwareCounters] " << m_experiment << ", " << p.first << ": cycles: " << c.m_cycles << ", instructions: " << c.m_instructions << ", "
+                "IPC: " << (c.m_cycles > 0 ? static_cast<double>(c.m_instructions) / c.m_cycles : 0.) << ", LLC misses: " << c.m_llc_misses << ", "
+                "dTLB misses: " << c.m_dtlb_misses << ", branch misses: " << c.m_branch_misses);
+    }
+}
+
+void HardwareCountersLog::save(common::Database* handle) const {
+    assert(handle != nullptr && "Null pointer");
+    if(handle == nullptr) INVALID_ARGUMENT("The handle to the database is a nullptr");
+
+    scoped_lock<mutex> lock(m_mutex);
+    for(const auto& p : m_phases){
+        const HardwareCounters& c = p.second.m_counters;
+        auto db = handle->add("hardware_counters");
+        db.add("experiment", m_experiment);
+        db.add("phase", p.first);
+        db.add("num_samples", p.second.m_num_samples);
+        db.add("cycles", c.m_cycles);
+        db.add("instructions", c.m_instructions);
+        db.add("llc_misses", c.m_llc_misses);
+        db.add("dtlb_misses", c.m_dtlb_misses);
+        db.add("branch_misses", c.m_branch_misses);
+    }
+}
+
+} // namespace
@@ -0,0 +1,107 @@
+/**
+ * Copyright (C) 2019 Dean De Leo, email: dleo[at]cwi.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cinttypes>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace common { class Database; } // forward declaration
+
+namespace gfe::experiment::details {
+
+/**
+ * The hardware events sampled for each thread, as counted by libpapi
+ */
+struct HardwareCounters {
+    int64_t m_cycles = 0; // total number of cycles
+    int64_t m_instructions = 0; // total number of instructions retired
+    int64_t m_llc_misses = 0; // misses in the last level cache
+    int64_t m_dtlb_misses = 0; // misses in the data TLB
+    int64_t m_branch_misses = 0; // mispredicted branches
+
+    HardwareCounters& operator+=(const HardwareCounters& other);
+    HardwareCounters operator-(const HardwareCounters& other) const;
+};
+
+/**
+ * Count the hardware events of the calling thread, from its creation up to its destruction. The instance must be
+ * created and used by the same thread. When the driver has not been compiled with libpapi, all counters are zero.
+ */
+class HardwareCountersThread {
+    HardwareCountersThread(const HardwareCountersThread&) = delete;
+    HardwareCountersThread& operator=(const HardwareCountersThread&) = delete;
+
+    int m_event_set; // the PAPI event set of the calling thread
+    bool m_available[5]; // which events have been added to the event set, the same order of the fields in HardwareCounters
+    HardwareCounters m_last_sample; // the value of the counters at the last invocation of #sample()
+
+    // Read the current value of the counters
+    HardwareCounters read();
+
+public:
+    // Start counting the events of the calling thread
+    // @param inherit whether to also count the events of the threads spawned by the calling thread from now on
+    HardwareCountersThread(bool inherit = false);
+
+    // Stop counting
+    ~HardwareCountersThread();
+
+    // Retrieve the events occurred since the last invocation of this method, or since the creation of the instance
+    HardwareCounters sample();
+
+    // Whether the driver has been compiled with libpapi
+    static bool is_supported();
+};
+
+/**
+ * Thread-safe aggregate of the hardware events sampled by the threads of an experiment, for each phase
+ * (e.g. load, run) or kernel (e.g. bfs, pagerank). The results are stored in the table `hardware_counters'.
+ */
+class HardwareCountersLog {
+    HardwareCountersLog(const HardwareCountersLog&) = delete;
+    HardwareCountersLog& operator=(const HardwareCountersLog&) = delete;
+
+    struct Phase {
+        HardwareCounters m_counters; // sum of all samples recorded for the phase
+        uint64_t m_num_samples = 0; // number of samples recorded
+    };
+
+    const std::string m_experiment; // the name of the experiment, stored in the results
+    mutable std::mutex m_mutex; // sync the access to m_phases
+    std::map<std::string, Phase> m_phases; // the counters recorded so far
+
+public:
+    // Create an empty log
+    HardwareCountersLog(const std::string& experiment);
+
+    // Add the sample of a thread to the given phase
+    void record(const std::string& phase, const HardwareCounters& sample);
+
+    // Retrieve the counters recorded for the given phase, all zeros if the phase has not been recorded
+    HardwareCounters get(const std::string& phase) const;
+
+    // Log the counters recorded to stdout
+    void report() const;
+
+    // Store the counters recorded into the table `hardware_counters' of the database
+    void save(common::Database* db) const;
+};
+
+} // namespace
@@ -20,6 +20,8 @@
 #include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <cmath>
+#include <cstring>
 #include <limits>
 #include "common/database.hpp"
 #include "common/quantity.hpp"
@@ -75,6 +77,24 @@ LatencyStatistics LatencyStatistics::compute_statistics(uint64_t* arr_latencies_
     return instance;
 }
 
+LatencyStatistics LatencyStatistics::compute_statistics(const LatencyHistogram& histogram){
+    LatencyStatistics instance;
+    if(histogram.num_samples() == 0) return instance;
+
+    instance.m_num_operations = histogram.num_samples();
+    instance.m_mean = histogram.mean();
+    instance.m_stddev = histogram.stddev();
+    instance.m_min = histogram.min();
+    instance.m_max = histogram.max();
+    instance.m_median = histogram.percentile(50);
+    instance.m_percentile90 = histogram.percentile(90);
+    instance.m_percentile95 = histogram.percentile(95);
+    instance.m_percentile97 = histogram.percentile(97);
+    instance.m_percentile99 = histogram.percentile(99);
+
+    return instance;
+}
+
 chrono::nanoseconds LatencyStatistics::mean() const {
     return chrono::nanoseconds(m_mean);
 }
@@ -116,4 +136,63 @@ std::ostream& operator<<(std::ostream& out, const LatencyStatistics& stats){
     return out;
 }
 
+/*****************************************************************************
+ *                                                                           *
+ *  LatencyHistogram                                                         *
+ *                                                                           *
+ *****************************************************************************/
+LatencyHistogram::LatencyHistogram() : m_buckets(new uint64_t[NUM_BUCKETS]) {
+    memset(m_buckets.get(), 0, sizeof(uint64_t) * NUM_BUCKETS);
+}
+
+uint64_t LatencyHistogram::value_of(uint64_t bucket){
+    if(bucket < SUBBUCKET_COUNT) return bucket;
+    uint64_t shift = bucket / SUBBUCKET_COUNT -1;
+    uint64_t lower = (SUBBUCKET_COUNT + bucket % SUBBUCKET_COUNT) << shift;
+    return lower + ((1ull << shift) /2);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& histogram){
+    for(uint64_t i = 0; i < NUM_BUCKETS; i++){
+        m_buckets[i] += histogram.m_buckets[i];
+    }
+    m_num_samples += histogram.m_num_samples;
+    m_sum += histogram.m_sum;
+    m_sum2 += histogram.m_sum2;
+    m_min = std::min(m_min, histogram.m_min);
+    m_max = std::max(m_max, histogram.m_max);
+}
+
+uint64_t LatencyHistogram::mean() const {
+    return m_num_samples == 0 ? 0 : m_sum / m_num_samples;
+}
+
+uint64_t LatencyHistogram::stddev() const {
+    if(m_num_samples == 0) return 0;
+    double mean = static_cast<double>(m_sum) / m_num_samples;
+    double variance = m_sum2 / m_num_samples - mean * mean;
+    return variance > 0 ? static_cast<uint64_t>(sqrt(variance)) : 0;
+}
+
+uint64_t LatencyHistogram::min() const {
+    return m_num_samples == 0 ? 0 : m_min;
+}
+
+uint64_t LatencyHistogram::percentile(double p) const {
+    assert(p > 0 && p <= 100);
+    if(m_num_samples == 0) return 0;
+
+    uint64_t rank = static_cast<uint64_t>(ceil(p * m_num_samples / 100.0)); // 1-based
+    if(rank == 0) rank = 1;
+    uint64_t count = 0;
+    uint64_t bucket = 0;
+    while(bucket < NUM_BUCKETS -1 && count + m_buckets[bucket] < rank){
+        count += m_buckets[bucket];
+        bucket++;
+    }
+
+    // the representative of a bucket may lie outside the range of the actual values recorded
+    return std::max(m_min, std::min(m_max, value_of(bucket)));
+}
+
 } // namespace
@@ -20,11 +20,15 @@
 #include <cinttypes>
 #include <chrono>
 #include <cstdint>
+#include <limits>
+#include <memory>
 #include <ostream>
 #include <string>
 
 namespace gfe::experiment::details {
 
+class LatencyHistogram; // forward declaration
+
 class LatencyStatistics {
     friend std::ostream& operator<<(std::ostream& out, const LatencyStatistics& stats);
     uint64_t m_num_operations {0};
@@ -46,6 +50,11 @@ public:
      */
     static LatencyStatistics compute_statistics(uint64_t* arr_latencies_nanosecs, uint64_t arr_latencies_sz);
 
+    /**
+     * Compute the statistics from the given histogram. The percentiles are approximated by the histogram buckets.
+     */
+    static LatencyStatistics compute_statistics(const LatencyHistogram& histogram);
+
     /**
      * Save the statistics into the table "latency" with the given value for the attribute `type'
      */
@@ -69,4 +78,83 @@ public:
 
 std::ostream& operator<<(std::ostream& out, const LatencyStatistics& stats);
 
+
+/**
+ * A histogram of latencies with log-linear buckets. The values are grouped by their power of two, and each power of two
+ * is further split into 2^SUBBUCKET_BITS linear buckets, bounding the relative error of the percentiles to ~3%.
+ * Recording a value does not allocate memory, so that each thread can keep its own instance and merge it at the end.
+ */
+class LatencyHistogram {
+    constexpr static uint64_t SUBBUCKET_BITS = 5; // number of linear buckets for each power of two, in log2
+    constexpr static uint64_t SUBBUCKET_COUNT = 1ull << SUBBUCKET_BITS;
+    constexpr static uint64_t MAX_EXPONENT = 40; // latencies greater than 2^40 nanosecs (~18 minutes) are clamped in the last bucket
+    constexpr static uint64_t NUM_BUCKETS = (MAX_EXPONENT - SUBBUCKET_BITS +1) * SUBBUCKET_COUNT;
+
+    std::unique_ptr<uint64_t[]> m_buckets; // the counters for each bucket
+    uint64_t m_num_samples = 0; // total number of values recorded
+    uint64_t m_sum = 0; // sum of all values recorded, in nanosecs
+    double m_sum2 = 0; // sum of the squares of the values recorded
+    uint64_t m_min = std::numeric_limits<uint64_t>::max(); // the smallest value recorded, in nanosecs
+    uint64_t m_max = 0; // the greatest value recorded, in nanosecs
+
+    // Retrieve the bucket for the given value
+    static uint64_t bucket_of(uint64_t value);
+
+    // Retrieve a representative value, the midpoint, of the given bucket
+    static uint64_t value_of(uint64_t bucket);
+
+public:
+    // Create an empty histogram
+    LatencyHistogram();
+
+    // Record the latency of an operation, in nanosecs
+    void record(uint64_t nanosecs);
+    void record(std::chrono::nanoseconds latency){ record(latency.count()); }
+
+    // Add all values from the given histogram into this instance
+    void merge(const LatencyHistogram& histogram);
+
+    // Total number of values recorded
+    uint64_t num_samples() const { return m_num_samples; }
+
+    // The average of the values recorded, in nanosecs
+    uint64_t mean() const;
+
+    // The standard deviation of the values recorded, in nanosecs
+    uint64_t stddev() const;
+
+    // The smallest value recorded, in nanosecs
+    uint64_t min() const;
+
+    // The greatest value recorded, in nanosecs
+    uint64_t max() const { return m_max; }
+
+    // Retrieve the approximate percentile of the values recorded, in nanosecs. The argument must be in (0, 100].
+    uint64_t percentile(double p) const;
+};
+
+/*****************************************************************************
+ *                                                                           *
+ *  Implementation details                                                   *
+ *                                                                           *
+ *****************************************************************************/
+inline
+uint64_t LatencyHistogram::bucket_of(uint64_t value){
+    if(value < SUBBUCKET_COUNT) return value;
+    uint64_t exponent = 63 - __builtin_clzl(value);
+    if(exponent >= MAX_EXPONENT) return NUM_BUCKETS -1;
+    uint64_t shift = exponent - SUBBUCKET_BITS;
+    return (shift +1) * SUBBUCKET_COUNT + ((value >> shift) - SUBBUCKET_COUNT);
+}
+
+inline
+void LatencyHistogram::record(uint64_t nanosecs){
+    m_buckets[bucket_of(nanosecs)]++;
+    m_num_samples++;
+    m_sum += nanosecs;
+    m_sum2 += static_cast<double>(nanosecs) * nanosecs;
+    if(nanosecs < m_min) m_min = nanosecs;
+    if(nanosecs > m_max) m_max = nanosecs;
+}
+
 } // namespace
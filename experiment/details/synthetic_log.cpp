@@ -0,0 +1,266 @@
+/**
+ * Copyright (C) 2019 Dean De Leo, email: dleo[at]cwi.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "synthetic_log.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+
+#include "common/error.hpp"
+#include "common/timer.hpp"
+#include "configuration.hpp"
+#include "reader/reader.hpp"
+
+using namespace common;
+using namespace std;
+
+namespace gfe::experiment::details {
+
+/*****************************************************************************
+ *                                                                           *
+ * Pattern                                                                   *
+ *                                                                           *
+ *****************************************************************************/
+SyntheticPattern parse_synthetic_pattern(const std::string& value){
+    string v = value;
+    transform(begin(v), end(v), begin(v), ::tolower);
+    if(v == "uniform"){
+        return SyntheticPattern::UNIFORM;
+    } else if (v == "zipf"){
+        return SyntheticPattern::ZIPF;
+    } else if (v == "window" || v == "sliding_window"){
+        return SyntheticPattern::WINDOW;
+    } else if (v == "burst" || v == "bursts"){
+        return SyntheticPattern::BURST;
+    } else {
+        INVALID_ARGUMENT("Invalid synthetic pattern: `" << value << "'. Expected one of: uniform, zipf, window or burst");
+    }
+}
+
+const char* synthetic_pattern_to_string(SyntheticPattern pattern){
+    switch(pattern){
+    case SyntheticPattern::UNIFORM: return "uniform";
+    case SyntheticPattern::ZIPF: return "zipf";
+    case SyntheticPattern::WINDOW: return "window";
+    case SyntheticPattern::BURST: return "burst";
+    default: return "unknown";
+    }
+}
+
+/*****************************************************************************
+ *                                                                           *
+ * Init                                                                      *
+ *                                                                           *
+ *****************************************************************************/
+SyntheticLog::SyntheticLog(const std::string& path_graph, SyntheticPattern pattern, double aging_coeff, uint64_t seed) :
+        m_pattern(pattern), m_aging_coeff(aging_coeff), m_seed(seed) {
+    if(aging_coeff < 1){ INVALID_ARGUMENT("The aging coefficient must be >= 1: " << aging_coeff); }
+
+    read_graph(path_graph);
+    if(m_vertices.size() < 2){ ERROR("The graph `" << path_graph << "' must contain at least two vertices to generate the temporary edges"); }
+    m_num_temporary_edges = static_cast<uint64_t>( ::round( (m_aging_coeff -1.0) * m_final_edges.size() / 2.0 ) );
+
+    reset();
+}
+
+void SyntheticLog::read_graph(const std::string& path_graph){
+    LOG("[SyntheticLog] Loading the final graph from " << path_graph << " ...");
+    Timer timer; timer.start();
+
+    auto reader = reader::Reader::open(path_graph);
+    m_is_directed = reader->is_directed();
+    unordered_set<uint64_t> vertices;
+    graph::WeightedEdge edge;
+    while(reader->read(edge)){
+        if(!m_final_edges_set.insert(canonical(edge.edge())).second) continue; // duplicate
+        m_final_edges.push_back(edge);
+        vertices.insert(edge.source());
+        vertices.insert(edge.destination());
+    }
+
+    // shuffle both the vertices and the edges, so that the same seed always produces the same sequence of updates
+    mt19937_64 random { m_seed };
+    m_vertices.assign(begin(vertices), end(vertices));
+    sort(begin(m_vertices), end(m_vertices));
+    shuffle(begin(m_vertices), end(m_vertices), random);
+    shuffle(begin(m_final_edges), end(m_final_edges), random);
+
+    timer.stop();
+    LOG("[SyntheticLog] Final graph loaded in " << timer << ", vertices: " << m_vertices.size() << ", edges: " << m_final_edges.size());
+}
+
+void SyntheticLog::init_zipf(){
+    m_zipf_cdf.resize(m_vertices.size());
+    double sum = 0;
+    for(uint64_t i = 0; i < m_zipf_cdf.size(); i++){
+        sum += 1.0 / ::pow(static_cast<double>(i +1), m_zipf_alpha);
+        m_zipf_cdf[i] = sum;
+    }
+}
+
+void SyntheticLog::reset(){
+    m_random.seed(m_seed);
+    m_time = 0;
+    m_final_position = 0;
+    m_temporary_inserted = 0;
+    m_pending = decltype(m_pending){};
+    m_live_edges.clear();
+}
+
+void SyntheticLog::set_zipf_alpha(double value){
+    if(value <= 0){ INVALID_ARGUMENT("The exponent of the Zipf distribution must be > 0: " << value); }
+    m_zipf_alpha = value;
+    m_zipf_cdf.clear(); // recompute
+}
+
+void SyntheticLog::set_window(uint64_t num_operations){
+    m_window = num_operations;
+}
+
+void SyntheticLog::set_burst_period(uint64_t num_operations){
+    m_burst_period = num_operations;
+}
+
+void SyntheticLog::set_burst_fraction(double value){
+    if(value <= 0 || value > 1){ INVALID_ARGUMENT("The fraction of a burst must be in (0, 1]: " << value); }
+    m_burst_fraction = value;
+}
+
+uint64_t SyntheticLog::block_size() const {
+    return 3 * max<uint64_t>(1, min<uint64_t>(num_operations(), 1ull << 20));
+}
+
+/*****************************************************************************
+ *                                                                           *
+ * Generation                                                                *
+ *                                                                           *
+ *****************************************************************************/
+graph::Edge SyntheticLog::canonical(graph::Edge edge) const {
+    if(!m_is_directed && edge.source() > edge.destination()){ edge.swap_src_dst(); }
+    return edge;
+}
+
+uint64_t SyntheticLog::next_source(){
+    if(m_pattern == SyntheticPattern::ZIPF){
+        double value = uniform_real_distribution<double>{0, m_zipf_cdf.back()}(m_random);
+        uint64_t index = upper_bound(begin(m_zipf_cdf), end(m_zipf_cdf), value) - begin(m_zipf_cdf);
+        return m_vertices[ min<uint64_t>(index, m_vertices.size() -1) ];
+    } else {
+        return m_vertices[ uniform_int_distribution<uint64_t>{0, m_vertices.size() -1}(m_random) ];
+    }
+}
+
+graph::Edge SyntheticLog::next_temporary_edge(){
+    constexpr uint64_t max_attempts = (1ull << 20);
+    for(uint64_t i = 0; i < max_attempts; i++){
+        uint64_t source = next_source();
+        uint64_t destination = m_vertices[ uniform_int_distribution<uint64_t>{0, m_vertices.size() -1}(m_random) ];
+        if(source == destination) continue;
+
+        graph::Edge edge { source, destination };
+        graph::Edge key = canonical(edge);
+        if(m_final_edges_set.count(key) > 0 || m_live_edges.count(key) > 0) continue;
+
+        return edge;
+    }
+
+    ERROR("Cannot generate a new temporary edge after " << max_attempts << " attempts, the graph is too dense for the window set. "
+            "Live temporary edges: " << m_live_edges.size());
+}
+
+uint64_t SyntheticLog::next_delay(){
+    const uint64_t window = m_window > 0 ? m_window : max<uint64_t>(1, m_final_edges.size());
+    if(m_pattern == SyntheticPattern::WINDOW){
+        return window;
+    } else {
+        return uniform_int_distribution<uint64_t>{1, 2 * window}(m_random);
+    }
+}
+
+bool SyntheticLog::is_burst_active() const {
+    const uint64_t period = m_burst_period > 0 ? m_burst_period : max<uint64_t>(1, num_operations() / 10);
+    return (m_time % period) < static_cast<uint64_t>(::ceil(m_burst_fraction * period));
+}
+
+uint64_t SyntheticLog::load(uint64_t* array, uint64_t max_num_edges){
+    if(m_pattern == SyntheticPattern::ZIPF && m_zipf_cdf.empty()){ init_zipf(); }
+
+    uint64_t* __restrict sources = array;
+    uint64_t* __restrict destinations = array + max_num_edges;
+    double* __restrict weights = reinterpret_cast<double*>(array + 2 * max_num_edges);
+
+    uint64_t num_edges = 0;
+    while(num_edges < max_num_edges){
+        const uint64_t remaining_final = m_final_edges.size() - m_final_position;
+        const uint64_t remaining_temporary = m_num_temporary_edges - m_temporary_inserted;
+        const bool has_insertions = remaining_final > 0 || remaining_temporary > 0;
+
+        graph::Edge edge;
+        double weight;
+        if(!m_pending.empty() && (m_pending.top().m_time <= m_time || !has_insertions)){ // deletion
+            edge = m_pending.top().m_edge;
+            m_pending.pop();
+            m_live_edges.erase(canonical(edge));
+            weight = -1.0;
+        } else if(has_insertions) {
+            bool is_temporary;
+            if(remaining_temporary == 0){
+                is_temporary = false;
+            } else if(remaining_final == 0){
+                is_temporary = true;
+            } else if(m_pattern == SyntheticPattern::BURST){
+                is_temporary = is_burst_active();
+            } else {
+                is_temporary = uniform_int_distribution<uint64_t>{0, remaining_final + remaining_temporary -1}(m_random) < remaining_temporary;
+            }
+
+            if(is_temporary){
+                edge = next_temporary_edge();
+                m_live_edges.insert(canonical(edge));
+                m_pending.push(PendingDeletion{ m_time + next_delay(), edge });
+                m_temporary_inserted++;
+                weight = 0.0; // the actual weight is generated by the worker
+            } else {
+                const graph::WeightedEdge& final_edge = m_final_edges[m_final_position++];
+                edge = final_edge.edge();
+                weight = max(0.0, final_edge.weight());
+            }
+        } else { // done
+            break;
+        }
+
+        sources[num_edges] = edge.source();
+        destinations[num_edges] = edge.destination();
+        weights[num_edges] = weight;
+        num_edges++;
+        m_time++;
+    }
+
+    // compact the block, as the destinations & weights are expected right after the last source
+    if(num_edges < max_num_edges){
+        memmove(array + num_edges, destinations, num_edges * sizeof(uint64_t));
+        memmove(array + 2 * num_edges, weights, num_edges * sizeof(double));
+    }
+
+    if(num_edges == 0){ reset(); } // the next invocation restarts the sequence
+    return num_edges;
+}
+
+} // namespace
@@ -0,0 +1,204 @@
+/**
+ * Copyright (C) 2019 Dean De Leo, email: dleo[at]cwi.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cinttypes>
+#include <functional>
+#include <queue>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "graph/edge.hpp"
+
+namespace gfe::experiment {
+
+/**
+ * The pattern of the temporary edges generated by a synthetic log for the Aging experiment
+ */
+enum class SyntheticPattern {
+    UNIFORM, // the endpoints of the temporary edges are uniformly distributed among the vertices
+    ZIPF, // the sources of the temporary edges follow a Zipf distribution, a few hot vertices receive most of the updates
+    WINDOW, // each temporary edge is removed exactly after a fixed number of operations, as in a sliding window
+    BURST // the temporary edges are inserted in periodic bursts, the rest of the period only inserts the final edges
+};
+
+} // namespace
+
+namespace gfe::experiment::details {
+
+/**
+ * Parse the pattern from its string representation: uniform, zipf, window or burst
+ */
+SyntheticPattern parse_synthetic_pattern(const std::string& value);
+
+/**
+ * Get the string representation of the given pattern
+ */
+const char* synthetic_pattern_to_string(SyntheticPattern pattern);
+
+/**
+ * Generate in the driver a sequence of updates, in place of a graphlog file, for the Aging experiment. The final graph
+ * is read from the given file, its edges are interleaved with the insertions and deletions of temporary edges between
+ * the same vertices, until the total number of updates is `aging_coeff' times the number of edges in the final graph.
+ * Temporary edges never overlap with the final edges nor with the temporary edges still alive, and no artificial vertex
+ * is created.
+ *
+ * The updates are produced in blocks, in the same layout of the blocks of a graphlog: an array with the sources, followed
+ * by an array with the destinations, followed by an array with the weights. A weight of -1 denotes a deletion, a weight
+ * of 0 a temporary insertion, whose actual weight is generated by the worker.
+ *
+ * This class is not thread-safe.
+ */
+class SyntheticLog {
+    SyntheticLog(const SyntheticLog&) = delete;
+    SyntheticLog& operator=(const SyntheticLog&) = delete;
+
+    struct PendingDeletion {
+        uint64_t m_time; // when the edge is due to be removed, in number of operations
+        graph::Edge m_edge; // the temporary edge to remove
+        bool operator>(const PendingDeletion& other) const { return m_time > other.m_time; }
+    };
+
+    const SyntheticPattern m_pattern; // the distribution of the temporary edges
+    const double m_aging_coeff; // the total number of updates w.r.t. the number of edges in the final graph
+    const uint64_t m_seed; // the seed used by the random generator, to reset it when the generation restarts
+    bool m_is_directed = false; // whether the final graph is directed
+    std::vector<uint64_t> m_vertices; // the vertices of the final graph, in random order
+    std::vector<graph::WeightedEdge> m_final_edges; // the edges of the final graph, in random order
+    std::unordered_set<graph::Edge> m_final_edges_set; // the edges of the final graph, in canonical form when the graph is undirected
+    std::vector<double> m_zipf_cdf; // the cumulative distribution of the sources, with the pattern ZIPF
+    uint64_t m_num_temporary_edges = 0; // total number of temporary edges to insert (and delete)
+    double m_zipf_alpha = 1.0; // the exponent of the Zipf distribution
+    uint64_t m_window = 0; // the average number of operations between the insertion & the deletion of a temporary edge
+    uint64_t m_burst_period = 0; // the length of a period, in number of operations, with the pattern BURST
+    double m_burst_fraction = 0.1; // the fraction of each period where the temporary edges are inserted, with the pattern BURST
+
+    // state of the generation
+    std::mt19937_64 m_random; // pseudo-random generator
+    uint64_t m_time = 0; // the number of operations generated so far
+    uint64_t m_final_position = 0; // the next final edge to insert
+    uint64_t m_temporary_inserted = 0; // the number of temporary edges inserted so far
+    std::priority_queue<PendingDeletion, std::vector<PendingDeletion>, std::greater<PendingDeletion>> m_pending; // the temporary edges to remove, sorted by their due time
+    std::unordered_set<graph::Edge> m_live_edges; // the temporary edges inserted but not removed yet
+
+    // Read the final graph
+    void read_graph(const std::string& path_graph);
+
+    // Compute the Zipf distribution for the sources of the temporary edges
+    void init_zipf();
+
+    // Restart the generation from the first operation
+    void reset();
+
+    // Select the source of a temporary edge
+    uint64_t next_source();
+
+    // Create a new temporary edge, which is neither a final edge nor a temporary edge currently alive
+    graph::Edge next_temporary_edge();
+
+    // Number of operations before the deletion of the temporary edge inserted right now
+    uint64_t next_delay();
+
+    // Whether temporary edges can be inserted at the current time
+    bool is_burst_active() const;
+
+    // Canonical form of the edge, for the lookups in m_final_edges_set & m_live_edges
+    graph::Edge canonical(graph::Edge edge) const;
+
+public:
+    /**
+     * Create a new generator
+     * @param path_graph the final graph, in any format supported by reader::Reader
+     * @param pattern the distribution of the temporary edges
+     * @param aging_coeff the total number of updates w.r.t. the number of edges in the final graph, at least 1
+     * @param seed the seed of the random generator
+     */
+    SyntheticLog(const std::string& path_graph, SyntheticPattern pattern, double aging_coeff, uint64_t seed);
+
+    /**
+     * Set the exponent of the Zipf distribution, with the pattern ZIPF. Default: 1.0
+     */
+    void set_zipf_alpha(double value);
+
+    /**
+     * Set the average number of operations a temporary edge stays in the graph. With the pattern WINDOW, each temporary
+     * edge is removed exactly after this number of operations, otherwise after a random number of operations uniformly
+     * distributed in [1, 2 * window]. Default (0): the number of edges in the final graph.
+     */
+    void set_window(uint64_t num_operations);
+
+    /**
+     * Set the length of a period, in number of operations, with the pattern BURST. Default (0): one tenth of the total
+     * number of operations.
+     */
+    void set_burst_period(uint64_t num_operations);
+
+    /**
+     * Set the fraction of each period where the temporary edges are inserted, with the pattern BURST. Default: 0.1
+     */
+    void set_burst_fraction(double value);
+
+    /**
+     * Generate the next block of updates, in the same layout of a graphlog block: sources, destinations and weights.
+     * Each time the generation starts from the first operation, the same sequence of updates is produced.
+     * @param array the buffer where to store the block, it must have space for 3 * max_num_edges entries
+     * @param max_num_edges the max number of updates to generate
+     * @return the number of updates generated, 0 if the sequence has been completed
+     */
+    uint64_t load(uint64_t* array, uint64_t max_num_edges);
+
+    /**
+     * The pattern of the temporary edges
+     */
+    SyntheticPattern pattern() const { return m_pattern; }
+
+    /**
+     * The aging coefficient, the total number of updates w.r.t. the number of edges in the final graph
+     */
+    double aging_coeff() const { return m_aging_coeff; }
+
+    /**
+     * Whether the final graph is directed
+     */
+    bool is_directed() const { return m_is_directed; }
+
+    /**
+     * The number of vertices in the final graph
+     */
+    uint64_t num_vertices() const { return m_vertices.size(); }
+
+    /**
+     * The number of edges in the final graph
+     */
+    uint64_t num_edges_final() const { return m_final_edges.size(); }
+
+    /**
+     * The total number of operations (insertions & deletions) generated
+     */
+    uint64_t num_operations() const { return m_final_edges.size() + 2 * m_num_temporary_edges; }
+
+    /**
+     * The suggested size of a block, as the property `internal.edges.block_size' of a graphlog, that is, three times the
+     * max number of updates in a block
+     */
+    uint64_t block_size() const;
+};
+
+} // namespace
@@ -0,0 +1,148 @@
+/**
+ * Copyright (C) 2019 Dean De Leo, email: dleo[at]cwi.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "thread_placement.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#if defined(HAVE_LIBNUMA)
+#include <numa.h>
+#endif
+#include <thread>
+#include <vector>
+
+#include "common/error.hpp"
+#include "common/system.hpp"
+
+using namespace std;
+
+namespace gfe::experiment::details {
+
+/*****************************************************************************
+ *                                                                           *
+ * Topology                                                                  *
+ *                                                                           *
+ *****************************************************************************/
+// For each NUMA node, the list of its logical CPUs. Without libnuma, the machine is treated as a single node.
+static const vector<vector<int>>& cpus_per_node(){
+    static const vector<vector<int>> topology = [](){
+        vector<vector<int>> result;
+#if defined(HAVE_LIBNUMA)
+        if(numa_available() >= 0){
+            result.resize(numa_num_configured_nodes());
+            for(int cpu = 0, num_cpus = numa_num_configured_cpus(); cpu < num_cpus; cpu++){
+                int node = numa_node_of_cpu(cpu);
+                if(node >= 0 && node < static_cast<int>(result.size())){ result[node].push_back(cpu); }
+            }
+            result.erase(remove_if(begin(result), end(result), [](const vector<int>& cpus){ return cpus.empty(); }), end(result)); // memory-only nodes
+        }
+#endif
+        if(result.empty()){
+            result.emplace_back();
+            for(int cpu = 0, num_cpus = max<int>(1, thread::hardware_concurrency()); cpu < num_cpus; cpu++){ result[0].push_back(cpu); }
+        }
+        return result;
+    }();
+
+    return topology;
+}
+
+/*****************************************************************************
+ *                                                                           *
+ * Placement                                                                 *
+ *                                                                           *
+ *****************************************************************************/
+ThreadPlacement parse_thread_placement(const std::string& value){
+    string v = value;
+    transform(begin(v), end(v), begin(v), ::tolower);
+    if(v == "default"){
+        return ThreadPlacement::DEFAULT;
+    } else if (v == "none"){
+        return ThreadPlacement::NONE;
+    } else if (v == "compact"){
+        return ThreadPlacement::COMPACT;
+    } else if (v == "round_robin" || v == "roundrobin"){
+        return ThreadPlacement::ROUND_ROBIN;
+    } else {
+        ERROR("Invalid thread placement: `" << value << "'. Expected either default, none, compact or round_robin");
+    }
+}
+
+const char* thread_placement_to_string(ThreadPlacement placement){
+    switch(placement){
+    case ThreadPlacement::DEFAULT: return "default";
+    case ThreadPlacement::NONE: return "none";
+    case ThreadPlacement::COMPACT: return "compact";
+    case ThreadPlacement::ROUND_ROBIN: return "round_robin";
+    default: ERROR("Invalid placement: " << (int) placement);
+    }
+}
+
+int thread_placement_cpu(ThreadPlacement placement, uint64_t thread_index){
+    const auto& topology = cpus_per_node();
+
+    switch(placement){
+    case ThreadPlacement::DEFAULT: // skip the hyperthreads of the first 16 cores
+        if(thread_index < 4){
+            return thread_index;
+        } else if (thread_index < 8){
+            return thread_index + 4;
+        } else if (thread_index < 12){
+            return thread_index + 8;
+        } else {
+            return thread_index + 12;
+        }
+    case ThreadPlacement::NONE:
+        return -1;
+    case ThreadPlacement::COMPACT: {
+        uint64_t num_cpus = 0;
+        for(const auto& cpus : topology){ num_cpus += cpus.size(); }
+        uint64_t position = thread_index % num_cpus;
+        for(const auto& cpus : topology){
+            if(position < cpus.size()){ return cpus[position]; }
+            position -= cpus.size();
+        }
+        assert(0 && "Unreachable");
+        return -1;
+    } break;
+    case ThreadPlacement::ROUND_ROBIN: {
+        const auto& cpus = topology[thread_index % topology.size()];
+        return cpus[(thread_index / topology.size()) % cpus.size()];
+    } break;
+    default:
+        ERROR("Invalid placement: " << (int) placement);
+    }
+}
+
+int apply_thread_placement(ThreadPlacement placement, uint64_t thread_index){
+    int cpu = thread_placement_cpu(placement, thread_index);
+    if(cpu < 0) return cpu; // do not pin the thread
+
+    common::concurrency::pin_thread_to_cpu(cpu);
+
+#if defined(HAVE_LIBNUMA)
+    if(numa_available() >= 0){
+        int node = numa_node_of_cpu(cpu);
+        if(node >= 0){ numa_set_preferred(node); } // allocate the memory on the local node, fall back to the other nodes when full
+    }
+#endif
+
+    return cpu;
+}
+
+} // namespace
@@ -0,0 +1,61 @@
+/**
+ * Copyright (C) 2019 Dean De Leo, email: dleo[at]cwi.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cinttypes>
+#include <string>
+
+namespace gfe::experiment {
+
+/**
+ * How to pin the worker threads of an experiment to the logical CPUs of the machine
+ */
+enum class ThreadPlacement {
+    DEFAULT, // the historical fixed mapping of the Aging2 workers, tailored to our machines
+    NONE, // do not pin the threads, let the OS scheduler decide
+    COMPACT, // fill all CPUs of the first NUMA node, then move to the next node, and so on
+    ROUND_ROBIN // assign the threads to the NUMA nodes in round robin
+};
+
+} // namespace
+
+namespace gfe::experiment::details {
+
+/**
+ * Parse the placement policy from its string representation: default, none, compact or round_robin
+ */
+ThreadPlacement parse_thread_placement(const std::string& value);
+
+/**
+ * Get the string representation of the given placement policy
+ */
+const char* thread_placement_to_string(ThreadPlacement placement);
+
+/**
+ * Retrieve the logical CPU where to pin the thread with the given index (0, 1, 2, ...), or -1 if the thread should not be pinned
+ */
+int thread_placement_cpu(ThreadPlacement placement, uint64_t thread_index);
+
+/**
+ * Pin the current thread according to the given policy. When libnuma is available, also set the memory policy of the
+ * thread to prefer its local NUMA node, so that the memory first touched by the thread is allocated on the same node.
+ * @return the CPU where the thread has been pinned, or -1 if the thread has not been pinned
+ */
+int apply_thread_placement(ThreadPlacement placement, uint64_t thread_index);
+
+} // namespace
@@ -28,6 +28,7 @@
 #include "common/database.hpp"
 #include "common/filesystem.hpp"
 #include "common/timer.hpp"
+#include "details/hardware_counters.hpp"
 #include "library/interface.hpp"
 #include "reader/graphalytics_reader.hpp"
 #include "utility/graphalytics_validate.hpp"
@@ -35,6 +36,7 @@
 #include "statistics.hpp"
 
 using namespace common;
+using namespace gfe::experiment::details;
 using namespace gfe::utility;
 using namespace std;
 
@@ -125,6 +127,13 @@ std::chrono::microseconds GraphalyticsSequential::execute(){
     auto interface = m_interface.get();
     constexpr uint64_t max_num_errors = 10; // if validation is enabled
 
+    // count the events of the OpenMP threads spawned by the library as well
+    unique_ptr<HardwareCountersThread> counters;
+    if(configuration().measure_hardware_counters()){
+        if(!m_hardware_counters){ m_hardware_counters = make_shared<HardwareCountersLog>("graphalytics"); }
+        counters.reset( new HardwareCountersThread(/* inherit */ true) );
+    }
+
     Timer t_global, t_local;
     t_global.start();
 
@@ -135,9 +144,13 @@ std::chrono::microseconds GraphalyticsSequential::execute(){
             string path_tmp = get_temporary_path("bfs", i);
             const char* path_result = m_validate_output_enabled ? path_tmp.c_str() : nullptr;
             try {
+                if(counters){ counters->sample(); } // discard the events occurred before the kernel
+                if(m_listener && !m_listener->on_kernel_start("bfs")){ LOG(">> Skipped, the suite has been stopped"); break; }
                 t_local.start();
                 interface->bfs(m_properties.bfs.m_source_vertex, path_result);
-              t_local.stop();
+                t_local.stop();
+                if(m_listener){ m_listener->on_kernel_end("bfs", t_local.microseconds()); }
+                if(counters){ m_hardware_counters->record("bfs", counters->sample()); }
                 LOG(">> BFS Execution time: " << t_local);
                 m_exec_bfs.push_back(t_local.microseconds());
 
@@ -155,6 +168,7 @@ std::chrono::microseconds GraphalyticsSequential::execute(){
                 }
             } catch (library::TimeoutError& e){
                 LOG(">> BFS TIMEOUT");
+                if(m_listener){ m_listener->on_kernel_end("bfs", -1); }
                 m_exec_bfs.push_back(-1);
                 m_properties.bfs.m_enabled = false;
             } catch (utility::GraphalyticsValidateError& e){
@@ -169,9 +183,13 @@ std::chrono::microseconds GraphalyticsSequential::execute(){
             string path_tmp = get_temporary_path("cdlp", i);
             const char* path_result = m_validate_output_enabled ? path_tmp.c_str() : nullptr;
             try {
+                if(counters){ counters->sample(); } // discard the events occurred before the kernel
+                if(m_listener && !m_listener->on_kernel_start("cdlp")){ LOG(">> Skipped, the suite has been stopped"); break; }
                 t_local.start();
                 interface->cdlp(m_properties.cdlp.m_max_iterations, path_result);
                 t_local.stop();
+                if(m_listener){ m_listener->on_kernel_end("cdlp", t_local.microseconds()); }
+                if(counters){ m_hardware_counters->record("cdlp", counters->sample()); }
                 LOG(">> CDLP Execution time: " << t_local);
                 m_exec_cdlp.push_back(t_local.microseconds());
 
@@ -189,6 +207,7 @@ std::chrono::microseconds GraphalyticsSequential::execute(){
                 }
             } catch(library::TimeoutError& e){
                 LOG(">> CDLP TIMEOUT");
+                if(m_listener){ m_listener->on_kernel_end("cdlp", -1); }
                 m_exec_cdlp.push_back(-1);
                 m_properties.cdlp.m_enabled = false;
             } catch(utility::GraphalyticsValidateError& e){
@@ -203,9 +222,13 @@ std::chrono::microseconds GraphalyticsSequential::execute(){
             string path_tmp = get_temporary_path("lcc", i);
             const char* path_result = m_validate_output_enabled ? path_tmp.c_str() : nullptr;
             try {
+                if(counters){ counters->sample(); } // discard the events occurred before the kernel
+                if(m_listener && !m_listener->on_kernel_start("lcc")){ LOG(">> Skipped, the suite has been stopped"); break; }
                 t_local.start();
                 interface->lcc(path_result);
                 t_local.stop();
+                if(m_listener){ m_listener->on_kernel_end("lcc", t_local.microseconds()); }
+                if(counters){ m_hardware_counters->record("lcc", counters->sample()); }
                 LOG(">> LCC Execution time: " << t_local);
                 m_exec_lcc.push_back(t_local.microseconds());
 
@@ -223,6 +246,7 @@ std::chrono::microseconds GraphalyticsSequential::execute(){
                 }
             } catch(library::TimeoutError& e){
                 LOG(">> LCC TIMEOUT");
+                if(m_listener){ m_listener->on_kernel_end("lcc", -1); }
                 m_exec_lcc.push_back(-1);
                 m_properties.lcc.m_enabled = false;
             } catch(utility::GraphalyticsValidateError& e){
@@ -237,9 +261,13 @@ std::chrono::microseconds GraphalyticsSequential::execute(){
             string path_tmp = get_temporary_path("pagerank", i);
             const char* path_result = m_validate_output_enabled ? path_tmp.c_str() : nullptr;
             try {
+                if(counters){ counters->sample(); } // discard the events occurred before the kernel
+                if(m_listener && !m_listener->on_kernel_start("pagerank")){ LOG(">> Skipped, the suite has been stopped"); break; }
                 t_local.start();
                 interface->pagerank(m_properties.pagerank.m_num_iterations, m_properties.pagerank.m_damping_factor, path_result);
                 t_local.stop();
+                if(m_listener){ m_listener->on_kernel_end("pagerank", t_local.microseconds()); }
+                if(counters){ m_hardware_counters->record("pagerank", counters->sample()); }
                 LOG(">> PageRank Execution time: " << t_local);
                 m_exec_pagerank.push_back(t_local.microseconds());
 
@@ -257,6 +285,7 @@ std::chrono::microseconds GraphalyticsSequential::execute(){
                 }
             } catch(library::TimeoutError& e){
                 LOG(">> PageRank TIMEOUT");
+                if(m_listener){ m_listener->on_kernel_end("pagerank", -1); }
                 m_exec_pagerank.push_back(-1);
                 m_properties.pagerank.m_enabled = false;
             } catch(utility::GraphalyticsValidateError& e){
@@ -271,9 +300,13 @@ std::chrono::microseconds GraphalyticsSequential::execute(){
             string path_tmp = get_temporary_path("sssp", i);
             const char* path_result = m_validate_output_enabled ? path_tmp.c_str() : nullptr;
             try {
+                if(counters){ counters->sample(); } // discard the events occurred before the kernel
+                if(m_listener && !m_listener->on_kernel_start("sssp")){ LOG(">> Skipped, the suite has been stopped"); break; }
                 t_local.start();
                 interface->sssp(m_properties.sssp.m_source_vertex, path_result);
                 t_local.stop();
+                if(m_listener){ m_listener->on_kernel_end("sssp", t_local.microseconds()); }
+                if(counters){ m_hardware_counters->record("sssp", counters->sample()); }
                 LOG(">> SSSP Execution time: " << t_local);
                 m_exec_sssp.push_back(t_local.microseconds());
 
@@ -291,6 +324,7 @@ std::chrono::microseconds GraphalyticsSequential::execute(){
                 }
             } catch(library::TimeoutError& e){
                 LOG(">> SSSP TIMEOUT");
+                if(m_listener){ m_listener->on_kernel_end("sssp", -1); }
                 m_exec_sssp.push_back(-1);
                 m_properties.sssp.m_enabled = false;
             } catch(utility::GraphalyticsValidateError& e){
@@ -304,9 +338,13 @@ std::chrono::microseconds GraphalyticsSequential::execute(){
             string path_tmp = get_temporary_path("wcc", i);
             const char* path_result = m_validate_output_enabled ? path_tmp.c_str() : nullptr;
             try {
+                if(counters){ counters->sample(); } // discard the events occurred before the kernel
+                if(m_listener && !m_listener->on_kernel_start("wcc")){ LOG(">> Skipped, the suite has been stopped"); break; }
                 t_local.start();
                 interface->wcc(path_result);
                 t_local.stop();
+                if(m_listener){ m_listener->on_kernel_end("wcc", t_local.microseconds()); }
+                if(counters){ m_hardware_counters->record("wcc", counters->sample()); }
                 LOG(">> WCC Execution time: " << t_local);
                 m_exec_wcc.push_back(t_local.microseconds());
 
@@ -324,6 +362,7 @@ std::chrono::microseconds GraphalyticsSequential::execute(){
                 }
             } catch(library::TimeoutError& e){
                 LOG(">> WCC TIMEOUT");
+                if(m_listener){ m_listener->on_kernel_end("wcc", -1); }
                 m_exec_wcc.push_back(-1);
                 m_properties.wcc.m_enabled = false;
             } catch(utility::GraphalyticsValidateError& e){
@@ -371,6 +410,11 @@ void GraphalyticsSequential::report(bool save_in_db){
         if(save_in_db) stats.save("wcc");
     }
 
+    if(m_hardware_counters){
+        m_hardware_counters->report();
+        if(save_in_db) m_hardware_counters->save(configuration().db());
+    }
+
     if(!m_validate_results.empty()){
         uint64_t num_validation_errors = 0;
 
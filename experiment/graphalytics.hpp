@@ -26,6 +26,7 @@
 #include <vector>
 
 namespace gfe::library { class GraphalyticsInterface; } // forward decl.
+namespace gfe::experiment::details { class HardwareCountersLog; } // forward decl.
 
 namespace gfe::experiment {
 
@@ -57,6 +58,11 @@ struct GraphalyticsAlgorithms {
         bool m_enabled = false;
     } wcc;
 
+    /**
+     * All algorithms disabled, with their default properties
+     */
+    GraphalyticsAlgorithms() = default;
+
     /**
      * Load the properties of each algorithms from the given files
      */
@@ -66,6 +72,23 @@ struct GraphalyticsAlgorithms {
 std::ostream& operator<<(std::ostream& out, const GraphalyticsAlgorithms& props); // debug only
 
 
+/**
+ * Observe the execution of each kernel in the Graphalytics suite. The methods are invoked by the same thread executing the
+ * kernel, e.g. to pin a snapshot of the graph in the mixed workload.
+ */
+class GraphalyticsListener {
+public:
+    virtual ~GraphalyticsListener() = default;
+
+    // Invoked right before the execution of the given kernel (bfs, cdlp, lcc, pagerank, sssp or wcc). Return false to skip
+    // the kernel and the rest of the suite, without invoking #on_kernel_end
+    virtual bool on_kernel_start(const char* kernel) = 0;
+
+    // Invoked right after the execution of the given kernel, with its completion time in microsecs (-1 = timeout)
+    virtual void on_kernel_end(const char* kernel, int64_t completion_time) = 0;
+};
+
+
 /**
  * Execute one by one the algorithms of the Graphalytics suite, up to N times
  */
@@ -89,6 +112,9 @@ class GraphalyticsSequential{
     std::vector<int64_t> m_exec_sssp;
     std::vector<int64_t> m_exec_wcc;
 
+    std::shared_ptr<details::HardwareCountersLog> m_hardware_counters; // the hardware counters for each kernel (nullptr => not recorded)
+    GraphalyticsListener* m_listener = nullptr; // if not null, notified before and after the execution of each kernel
+
 private:
 
     /**
@@ -128,6 +154,11 @@ public:
      */
     void set_validate_remap_vertices(const std::string& path_properties_file);
 
+    /**
+     * Notify the given listener before and after the execution of each kernel. The listener is not owned by this instance.
+     */
+    void set_listener(GraphalyticsListener* listener){ m_listener = listener; }
+
     /**
      * Execute the experiment
      */
@@ -17,18 +17,25 @@
 
 #include "insert_only.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <future>
+#include <mutex>
 #include <thread>
 #include <vector>
 
 #include "common/database.hpp"
+#include "common/quantity.hpp"
 #include "common/system.hpp"
 #include "common/timer.hpp"
 #include "details/build_thread.hpp"
+#include "details/epoch_service.hpp"
+#include "details/hardware_counters.hpp"
+#include "details/latency.hpp"
 #include "configuration.hpp"
 #include "library/interface.hpp"
+#include "utility/memory_usage.hpp"
 
 using namespace common;
 using namespace gfe::experiment::details;
@@ -46,41 +53,116 @@ void InsertOnly::set_scheduler_granularity(uint64_t granularity) {
     m_scheduler_granularity = granularity;
 }
 
+void InsertOnly::set_measure_latency(bool value){
+    m_measure_latency = value;
+}
+
+void InsertOnly::set_latency_sampling(uint64_t sampling){
+    if(sampling == 0) INVALID_ARGUMENT("The sampling rate for the latencies cannot be zero");
+    m_latency_sampling = sampling;
+}
+
+void InsertOnly::set_scheduler(InsertionScheduler scheduler){
+    m_scheduler = scheduler;
+}
+
+void InsertOnly::set_worker_placement(ThreadPlacement placement){
+    m_worker_placement = placement;
+}
+
+void InsertOnly::set_insertion_order(InsertionOrder order){
+    m_insertion_order = order;
+}
+
+void InsertOnly::set_timeline_resolution(std::chrono::milliseconds millisecs){
+    if(millisecs > 0ms && millisecs < 100ms){ INVALID_ARGUMENT("The resolution of the timeline must be at least 100 ms, given: " << millisecs.count() << " ms"); }
+    m_timeline_resolution = millisecs;
+}
+
+void InsertOnly::set_memfp_physical(bool value){
+    m_memfp_physical = value;
+}
+
 void InsertOnly::set_build_frequency(std::chrono::milliseconds millisecs){
     m_build_frequency = millisecs;
 }
 
 // Execute an update at the time
-static void run_sequential(library::UpdateInterface* interface, graph::WeightedEdgeStream* graph, uint64_t start, uint64_t end){
+static void run_sequential(library::UpdateInterface* interface, graph::WeightedEdgeStream* graph, uint64_t start, uint64_t end, atomic<uint64_t>* progress){
     for(uint64_t pos = start; pos < end; pos++){
         auto edge = graph->get(pos);
         [[maybe_unused]] bool result = interface->add_edge_v2(edge);
         assert(result == true && "Edge not inserted");
+        if(progress){ progress->store(progress->load(memory_order_relaxed) +1, memory_order_relaxed); } // single writer
+    }
+}
+
+// Execute an update at the time, measuring the latency of one insertion every `sampling' insertions
+static void run_sequential_latency(library::UpdateInterface* interface, graph::WeightedEdgeStream* graph, uint64_t start, uint64_t end, atomic<uint64_t>* progress, LatencyHistogram& latencies, uint64_t sampling, uint64_t& countdown){
+    for(uint64_t pos = start; pos < end; pos++){
+        auto edge = graph->get(pos);
+        if(--countdown == 0){
+            countdown = sampling;
+            auto t0 = chrono::steady_clock::now();
+            [[maybe_unused]] bool result = interface->add_edge_v2(edge);
+            latencies.record( chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - t0) );
+            assert(result == true && "Edge not inserted");
+        } else {
+            [[maybe_unused]] bool result = interface->add_edge_v2(edge);
+            assert(result == true && "Edge not inserted");
+        }
+        if(progress){ progress->store(progress->load(memory_order_relaxed) +1, memory_order_relaxed); } // single writer
     }
 }
 
-void InsertOnly::execute_round_robin(){
+void InsertOnly::execute_workers(){
     vector<thread> threads;
 
     atomic<uint64_t> start_chunk_next = 0;
+    mutex mutex_latency; // to merge the latencies of the workers into m_latency
+    m_worker_stats.clear();
+    m_worker_stats.resize(m_num_threads);
     auto interface = m_interface.get();
-    interface->create_epoch(100);
+    EpochService::create_epoch(interface);
     for(int64_t i = 0; i < m_num_threads; i++){
-        threads.emplace_back([this, &start_chunk_next](int thread_id){
+        threads.emplace_back([this, &start_chunk_next, &mutex_latency](int thread_id){
             concurrency::set_thread_name("Worker #" + to_string(thread_id));
+            WorkerStatistics& stats = m_worker_stats[thread_id];
+            stats.m_cpu = apply_thread_placement(m_worker_placement, thread_id);
 
             auto interface = m_interface.get();
             auto graph = m_stream.get();
-            uint64_t start;
-            const uint64_t size = graph->num_edges();
+            uint64_t start, end;
+            StaticRange range = static_range(thread_id);
+            atomic<uint64_t>* progress = m_progress ? &(m_progress[thread_id].m_num_edges) : nullptr;
 
             interface->on_thread_init(thread_id);
+            unique_ptr<HardwareCountersThread> counters;
+            if(m_hardware_counters){ counters.reset( new HardwareCountersThread() ); }
+
+            unique_ptr<LatencyHistogram> latencies;
+            uint64_t countdown = m_latency_sampling;
+            if(m_latency){ latencies.reset( new LatencyHistogram() ); }
 
-            while( (start = start_chunk_next.fetch_add(m_scheduler_granularity)) < size ){
-                uint64_t end = std::min<uint64_t>(start + m_scheduler_granularity, size);
-                run_sequential(interface, graph, start, end);
+            Timer timer;
+            timer.start();
+            while( next_chunk(start_chunk_next, range, start, end) ){
+                if(latencies){
+                    run_sequential_latency(interface, graph, start, end, progress, *latencies, m_latency_sampling, countdown);
+                } else {
+                    run_sequential(interface, graph, start, end, progress);
+                }
+                stats.m_num_edges += end - start;
+                stats.m_num_chunks++;
             }
+            timer.stop();
+            stats.m_time = timer.microseconds();
 
+            if(counters){ m_hardware_counters->record("insert", counters->sample()); }
+            if(latencies){
+                scoped_lock<mutex> lock(mutex_latency);
+                m_latency->merge(*latencies);
+            }
             interface->on_thread_destroy(thread_id);
 
         }, static_cast<int>(i));
@@ -90,6 +172,137 @@ void InsertOnly::execute_round_robin(){
     for(auto& t : threads) t.join();
 }
 
+const char* insertion_scheduler_to_string(InsertionScheduler scheduler){
+    switch(scheduler){
+    case InsertionScheduler::STATIC: return "static";
+    case InsertionScheduler::DYNAMIC: return "dynamic";
+    case InsertionScheduler::GUIDED: return "guided";
+    default: return "unknown";
+    }
+}
+
+InsertionScheduler parse_insertion_scheduler(const std::string& value){
+    string scheduler = value;
+    transform(begin(scheduler), end(scheduler), begin(scheduler), ::tolower);
+    if(scheduler == "static"){
+        return InsertionScheduler::STATIC;
+    } else if(scheduler == "dynamic"){
+        return InsertionScheduler::DYNAMIC;
+    } else if(scheduler == "guided"){
+        return InsertionScheduler::GUIDED;
+    } else {
+        INVALID_ARGUMENT("Invalid scheduler: `" << value << "'. Expected either static, dynamic or guided");
+    }
+}
+
+const char* insertion_order_to_string(InsertionOrder order){
+    switch(order){
+    case InsertionOrder::RANDOM: return "random";
+    case InsertionOrder::SORTED_CHUNKS: return "sorted_chunks";
+    case InsertionOrder::VERTEX_PARTITIONED: return "vertex_partitioned";
+    default: return "unknown";
+    }
+}
+
+InsertionOrder parse_insertion_order(const std::string& value){
+    string order = value;
+    transform(begin(order), end(order), begin(order), ::tolower);
+    if(order == "random"){
+        return InsertionOrder::RANDOM;
+    } else if(order == "sorted_chunks"){
+        return InsertionOrder::SORTED_CHUNKS;
+    } else if(order == "vertex_partitioned"){
+        return InsertionOrder::VERTEX_PARTITIONED;
+    } else {
+        INVALID_ARGUMENT("Invalid insertion order: `" << value << "'. Expected either random, sorted_chunks or vertex_partitioned");
+    }
+}
+
+uint64_t InsertOnly::num_units() const {
+    return m_chunks.empty() ? m_stream->num_edges() : m_chunks.size() -1;
+}
+
+InsertOnly::StaticRange InsertOnly::static_range(int thread_id) const {
+    // split the units in blocks of the scheduler granularity, so that each range starts at the boundary of a block
+    const uint64_t units = num_units();
+    const uint64_t granularity = m_chunks.empty() ? m_scheduler_granularity : 1;
+    const uint64_t num_blocks = (units + granularity -1) / granularity;
+    const uint64_t start = std::min<uint64_t>(num_blocks * thread_id / m_num_threads * granularity, units);
+    const uint64_t end = std::min<uint64_t>(num_blocks * (thread_id +1) / m_num_threads * granularity, units);
+    return StaticRange{ start, end };
+}
+
+bool InsertOnly::next_chunk(atomic<uint64_t>& counter, StaticRange& range, uint64_t& start, uint64_t& end) const {
+    const uint64_t units = num_units();
+    const uint64_t granularity = m_chunks.empty() ? m_scheduler_granularity : 1; // with vertex_partitioned, one chunk at the time
+
+    uint64_t unit_start = 0, unit_end = 0;
+    switch(m_scheduler){
+    case InsertionScheduler::STATIC:
+        // process the range assigned to the worker in pieces of the scheduler granularity. The range starts at the boundary
+        // of a block (see #static_range), hence the pieces are the same chunks sorted with sorted_chunks
+        unit_start = range.m_next;
+        unit_end = std::min<uint64_t>(unit_start + granularity, range.m_end);
+        range.m_next = unit_end;
+        if(unit_start >= range.m_end) return false;
+        break;
+    case InsertionScheduler::DYNAMIC:
+        unit_start = counter.fetch_add(granularity);
+        if(unit_start >= units) return false;
+        unit_end = std::min<uint64_t>(unit_start + granularity, units);
+        break;
+    case InsertionScheduler::GUIDED: {
+        // as in OpenMP, the size of each chunk is proportional to the number of units still to process
+        unit_start = counter.load(memory_order_relaxed);
+        uint64_t size = 0;
+        do {
+            if(unit_start >= units) return false;
+            size = std::max<uint64_t>(granularity, (units - unit_start) / m_num_threads);
+        } while(!counter.compare_exchange_weak(unit_start, unit_start + size));
+        unit_end = std::min<uint64_t>(unit_start + size, units);
+    } break;
+    }
+
+    if(m_chunks.empty()){
+        start = unit_start;
+        end = unit_end;
+    } else { // vertex_partitioned
+        start = m_chunks[unit_start];
+        end = m_chunks[unit_end];
+    }
+    return true;
+}
+
+void InsertOnly::prepare_insertion_order(){
+    m_chunks.clear();
+
+    switch(m_insertion_order){
+    case InsertionOrder::RANDOM:
+        break; // nop, insert the edges in the same order of the stream
+    case InsertionOrder::SORTED_CHUNKS:
+        m_stream->sort_by_src_dst(m_scheduler_granularity);
+        break;
+    case InsertionOrder::VERTEX_PARTITIONED: {
+        m_stream->sort_by_src_dst();
+
+        // split the stream into chunks of at least m_scheduler_granularity edges, without splitting the edges of the same source vertex
+        const uint64_t size = m_stream->num_edges();
+        uint64_t start = 0;
+        while(start < size){
+            m_chunks.push_back(start);
+            uint64_t end = std::min<uint64_t>(start + m_scheduler_granularity, size);
+            if(end < size){
+                uint64_t source = m_stream->get(end -1).source();
+                while(end < size && m_stream->get(end).source() == source){ end++; }
+            }
+            start = end;
+        }
+        m_chunks.push_back(size);
+        LOG("InsertOnly: partitioned the stream by source vertex into " << m_chunks.size() -1 << " chunks");
+    } break;
+    }
+}
+
 chrono::microseconds InsertOnly::execute() {
     // re-adjust the scheduler granularity if there are too few insertions to perform
     if(m_stream->num_edges() / m_num_threads < m_scheduler_granularity){
@@ -98,25 +311,55 @@ chrono::microseconds InsertOnly::execute() {
         LOG("InsertOnly: reset the scheduler granularity to " << m_scheduler_granularity << " edge insertions per thread");
     }
 
+    prepare_insertion_order();
+
+    if(configuration().measure_hardware_counters()){
+        m_hardware_counters = make_shared<HardwareCountersLog>("insert_only");
+    }
+
+    if(m_measure_latency){
+        m_latency = make_shared<LatencyHistogram>();
+    }
+
+    m_event_log.clear();
+    m_timeline.clear();
+    if(m_timeline_resolution > 0ms){
+        m_progress.reset( new WorkerProgress[m_num_threads] );
+    }
+
     // Execute the insertions
     m_interface->on_main_init(m_num_threads /* build thread */ +1);
     m_interface->updates_start();
     Timer timer;
     timer.start();
-    BuildThread build_service { m_interface , static_cast<int>(m_num_threads), m_build_frequency };
-    execute_round_robin();
+    m_time_start = chrono::steady_clock::now();
+    timeline_start();
+    BuildThread build_service { m_interface , static_cast<int>(m_num_threads), m_build_frequency, &m_event_log };
+    execute_workers();
     build_service.stop();
     timer.stop();
     m_interface->updates_stop();
     LOG("Insertions performed with " << m_num_threads << " threads in " << timer);
+    for(uint64_t i = 0; i < m_worker_stats.size(); i++){
+        const auto& stats = m_worker_stats[i];
+        LOG("Worker #" << i << (stats.m_cpu >= 0 ? ", cpu: " + to_string(stats.m_cpu) : "") << ", edges inserted: " << stats.m_num_edges << ", "
+                "chunks: " << stats.m_num_chunks << ", time: " << DurationQuantity(chrono::microseconds(stats.m_time)) << ", "
+                "throughput: " << (stats.m_time > 0 ? static_cast<uint64_t>(stats.m_num_edges * 1000000.0 / stats.m_time) : 0) << " edges/sec");
+    }
     m_time_insert = timer.microseconds();
     m_num_build_invocations = build_service.num_invocations();
 
     // A final invocation of the method #build()
     m_interface->on_thread_init(0);
+    unique_ptr<HardwareCountersThread> counters;
+    if(m_hardware_counters){ counters.reset( new HardwareCountersThread() ); }
     timer.start();
+    auto t0 = chrono::steady_clock::now();
     m_interface->build();
+    m_event_log.record(EventLog::Type::BUILD, t0, chrono::steady_clock::now());
     timer.stop();
+    timeline_stop(); // include the final build in the timeline
+    if(counters){ m_hardware_counters->record("build", counters->sample()); counters.reset(); }
 
     m_time_build = timer.microseconds();
     if(m_time_build > 0){
@@ -129,24 +372,116 @@ chrono::microseconds InsertOnly::execute() {
     m_interface->on_thread_destroy(0);
     m_interface->on_main_destroy();
 
+    if(m_hardware_counters){ m_hardware_counters->report(); }
+    if(m_latency){
+        LOG("Latency of the insertions, sampled 1 in " << m_latency_sampling << ": " << LatencyStatistics::compute_statistics(*m_latency));
+    }
+
     return chrono::microseconds{ m_time_insert + m_time_build };
 }
 
 void InsertOnly::save() {
     assert(configuration().db() != nullptr);
     auto db = configuration().db()->add("insert_only");
-    db.add("scheduler", "round_robin"); // backwards compatibility
+    db.add("scheduler", m_scheduler == InsertionScheduler::DYNAMIC ? "round_robin" /* backwards compatibility */ : insertion_scheduler_to_string(m_scheduler));
+    db.add("placement", thread_placement_to_string(m_worker_placement));
     db.add("scheduler_granularity", m_scheduler_granularity); // the number of insertions performed by each thread
+    db.add("insertion_order", insertion_order_to_string(m_insertion_order));
     db.add("insertion_time", m_time_insert); // microseconds
     db.add("build_time", m_time_build); // microseconds
     db.add("num_edges", m_stream->num_edges());
     db.add("num_snapshots_created", m_interface->num_levels());
     db.add("num_build_invocations", m_num_build_invocations);
+    if(m_latency){ db.add("latency_sampling", m_latency_sampling); } // measure the latency of one insertion every `latency_sampling' insertions
     // missing revision: until 25/Nov/2019
     // version 20191125: build thread, build frequency taken into account, scheduler set to round_robin, removed batch updates
     // version 20191210: difference between num_build_invocations (explicit invocations to #build()) and num_snapshots_created (actual number of deltas created by the impl)
     // version 20200625: rely on #add_edge_v2 to implicitly create the vertices. This should alleviate the footprint of the driver for non scalable implementations
     db.add("revision", "20200625");
+
+    for(uint64_t i = 0; i < m_worker_stats.size(); i++){
+        const auto& stats = m_worker_stats[i];
+        auto db_thread = configuration().db()->add("insert_only_threads");
+        db_thread.add("worker_id", i);
+        db_thread.add("cpu", (int64_t) stats.m_cpu);
+        db_thread.add("num_edges", stats.m_num_edges);
+        db_thread.add("num_chunks", stats.m_num_chunks);
+        db_thread.add("time", stats.m_time); // microseconds
+    }
+
+    if(m_hardware_counters){ m_hardware_counters->save(configuration().db()); }
+    save_timeline();
+    if(m_latency){ LatencyStatistics::compute_statistics(*m_latency).save("inserts"); }
+}
+
+/*****************************************************************************
+ *                                                                           *
+ * Timeline                                                                  *
+ *                                                                           *
+ *****************************************************************************/
+void InsertOnly::timeline_start(){
+    if(m_timeline_resolution == 0ms) return; // timeline disabled
+    assert(!m_timeline_thread.joinable() && "Timeline already started");
+    m_timeline_terminate = false;
+    m_timeline_thread = thread{ &InsertOnly::main_timeline, this };
+}
+
+void InsertOnly::timeline_stop(){
+    if(!m_timeline_thread.joinable()) return; // not running
+    m_timeline_terminate = true;
+    m_timeline_thread.join();
+}
+
+void InsertOnly::main_timeline(){
+    concurrency::set_thread_name("InsertOnly timeline");
+    auto tp = m_time_start;
+
+    do {
+        tp += m_timeline_resolution;
+        this_thread::sleep_until(tp);
+
+        TimelineSample sample { 0, 0 };
+        for(int64_t i = 0; i < m_num_threads; i++){
+            sample.m_num_edges += m_progress[i].m_num_edges.load(memory_order_relaxed);
+        }
+        sample.m_memfp_process = m_memfp_physical ? common::get_memory_footprint() : max<int64_t>(utility::MemoryUsage::memory_footprint(), 0);
+        m_timeline.push_back(sample);
+    } while(!m_timeline_terminate);
+}
+
+void InsertOnly::save_timeline(){
+    if(m_timeline.empty()) return; // timeline disabled
+    using namespace std::chrono;
+    const auto events = m_event_log.events();
+    const uint64_t resolution = m_timeline_resolution.count(); // millisecs
+    uint64_t previous = 0; // number of edges inserted at the end of the previous window
+
+    for(uint64_t window_id = 0; window_id < m_timeline.size(); window_id++){
+        const auto& sample = m_timeline[window_id];
+
+        // invocations to #build() overlapping the window
+        uint64_t num_builds = 0, time_builds = 0;
+        steady_clock::time_point window_start = m_time_start + m_timeline_resolution * static_cast<int64_t>(window_id);
+        steady_clock::time_point window_end = window_start + m_timeline_resolution;
+        for(const auto& event : events){
+            if(event.m_type != EventLog::Type::BUILD || event.m_end < window_start || event.m_start >= window_end) continue;
+            num_builds += event.m_start >= window_start;
+            time_builds += duration_cast<microseconds>( min(event.m_end, window_end) - max(event.m_start, window_start) ).count();
+        }
+
+        auto db = configuration().db()->add("insert_only_timeline");
+        db.add("window", window_id);
+        db.add("time_start", window_id * resolution); // millisecs
+        db.add("resolution", resolution); // millisecs
+        db.add("num_edges", sample.m_num_edges - previous);
+        db.add("edges_per_sec", (sample.m_num_edges - previous) * 1000 / resolution);
+        db.add("num_edges_total", sample.m_num_edges);
+        db.add("memfp_process", sample.m_memfp_process); // bytes
+        db.add("num_builds", num_builds);
+        db.add("time_builds", time_builds); // microsecs
+
+        previous = sample.m_num_edges;
+    }
 }
 
 } // namespace
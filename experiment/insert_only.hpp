@@ -17,16 +17,63 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <cinttypes>
 #include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
+#include "details/event_log.hpp"
+#include "details/thread_placement.hpp"
 #include "graph/edge.hpp"
 #include "graph/edge_stream.hpp"
 #include "library/interface.hpp"
 
+namespace gfe::experiment::details { class HardwareCountersLog; } // forward declaration
+namespace gfe::experiment::details { class LatencyHistogram; } // forward declaration
+
 namespace gfe::experiment {
 
+/**
+ * The order in which the edges of the stream are inserted in the InsertOnly experiment
+ */
+enum class InsertionOrder {
+    RANDOM, // as given by the stream, usually randomly permuted
+    SORTED_CHUNKS, // each chunk handed to a worker is sorted by source vertex
+    VERTEX_PARTITIONED // the stream is sorted by source and each source vertex, with all its edges, is inserted by a single worker
+};
+
+/**
+ * How the edges of the stream are distributed among the workers of the InsertOnly experiment
+ */
+enum class InsertionScheduler {
+    STATIC, // each worker is assigned upfront a contiguous range of the stream, of the same size
+    DYNAMIC, // the workers fetch chunks of fixed size, one at the time, from a shared counter
+    GUIDED // as dynamic, but the size of the chunks is proportional to the edges still to insert, down to the scheduler granularity
+};
+
+/**
+ * Parse the scheduler from its string representation: static, dynamic or guided
+ */
+InsertionScheduler parse_insertion_scheduler(const std::string& value);
+
+/**
+ * Get the string representation of the given scheduler
+ */
+const char* insertion_scheduler_to_string(InsertionScheduler scheduler);
+
+/**
+ * Parse the insertion order from its string representation: random, sorted_chunks or vertex_partitioned
+ */
+InsertionOrder parse_insertion_order(const std::string& value);
+
+/**
+ * Get the string representation of the given insertion order
+ */
+const char* insertion_order_to_string(InsertionOrder order);
+
 /**
  * This experiment simulates only insertions (and no deletions) in a given graph system. It assumes that the system
  * to evaluate has already been created, and it is empty, that is, it should not already contain any vertices or edges.
@@ -39,26 +86,110 @@ class InsertOnly {
     const int64_t m_num_threads; // the number of threads to use
     std::chrono::milliseconds m_build_frequency {0}; // Continuously create a new snapshot each `m_build_frequency' millisecs (0 = feature disabled)
     uint64_t m_scheduler_granularity = 1ull << 20; // if >0, granularity for the scheduler
+    InsertionScheduler m_scheduler = InsertionScheduler::DYNAMIC; // how to distribute the edges among the workers
+    ThreadPlacement m_worker_placement = ThreadPlacement::NONE; // how to pin the workers to the logical CPUs
+    InsertionOrder m_insertion_order = InsertionOrder::RANDOM; // the order in which the edges are inserted
+    std::vector<uint64_t> m_chunks; // with the order vertex_partitioned, the start of each chunk in the stream, plus the end of the last chunk
     uint64_t m_time_insert = 0; // the amount of time to insert all elements in the database, in microseconds
     uint64_t m_time_build = 0; // the amount of time to build the last snapshot/delta/level in the library, in microseconds
     uint64_t m_num_build_invocations = 0; // number of times the method #build() has been invoked
+    std::shared_ptr<details::HardwareCountersLog> m_hardware_counters; // the hardware counters of the workers (nullptr => not recorded)
+    bool m_measure_latency = false; // whether to measure the latency of the insertions
+    uint64_t m_latency_sampling = 1; // measure the latency of one insertion every `m_latency_sampling' insertions
+    std::shared_ptr<details::LatencyHistogram> m_latency; // the latencies measured by all workers (nullptr => not measured)
+
+    // The statistics of a worker, on its own cache line as each worker updates its entry after each chunk
+    struct alignas(64) WorkerStatistics {
+        int m_cpu = -1; // the logical CPU where the worker has been pinned, -1 if not pinned
+        uint64_t m_num_edges = 0; // the number of edges inserted by the worker
+        uint64_t m_num_chunks = 0; // the number of chunks fetched from the scheduler
+        uint64_t m_time = 0; // the time the worker spent inserting the edges, in microseconds
+    };
+    std::vector<WorkerStatistics> m_worker_stats; // the statistics of each worker
+
+    // The number of edges inserted so far by a worker, on its own cache line as it is updated after each insertion
+    struct alignas(64) WorkerProgress {
+        std::atomic<uint64_t> m_num_edges = 0;
+    };
+    std::unique_ptr<WorkerProgress[]> m_progress; // the progress of each worker, read by the timeline (nullptr => timeline disabled)
+
+    // A single sample of the timeline, taken at the end of each window
+    struct TimelineSample {
+        uint64_t m_num_edges; // total number of edges inserted so far
+        uint64_t m_memfp_process; // the memory footprint of the whole process, in bytes
+    };
+    std::chrono::milliseconds m_timeline_resolution {0}; // the length of each window of the timeline (0 = disabled)
+    bool m_memfp_physical = false; // whether to measure the physical or the virtual memory in the memory footprint of the timeline
+    std::vector<TimelineSample> m_timeline; // the samples of the timeline, one for each window
+    std::chrono::steady_clock::time_point m_time_start; // when the insertions started
+    std::atomic<bool> m_timeline_terminate = false; // signal the timeline thread to stop
+    std::thread m_timeline_thread; // the thread sampling the timeline
+    details::EventLog m_event_log; // the invocations to #build() occurred during the experiment
+
+    // The range of units still to process by a worker, with the static scheduler
+    struct StaticRange {
+        uint64_t m_next; // the next unit to process
+        uint64_t m_end; // the end of the range, excluded
+    };
+
+    // Execute the insertions with the workers
+    void execute_workers();
+
+    // Start/stop the thread sampling the timeline
+    void timeline_start();
+    void timeline_stop();
+
+    // The logic of the thread sampling the timeline
+    void main_timeline();
+
+    // Store the timeline in the database
+    void save_timeline();
+
+    // Rearrange the stream according to the insertion order, before starting the experiment
+    void prepare_insertion_order();
 
-    // Execute the experiment with the round robin scheduler
-    void execute_round_robin();
+    // The number of units distributed by the scheduler: the edges of the stream or, with the order vertex_partitioned, the chunks in m_chunks
+    uint64_t num_units() const;
+
+    // The range of units assigned to the given worker by the static scheduler
+    StaticRange static_range(int thread_id) const;
+
+    // Fetch the next chunk of edges to insert, in [start, end). Return false if there are no more chunks to process
+    bool next_chunk(std::atomic<uint64_t>& counter, StaticRange& range, uint64_t& start, uint64_t& end) const;
 
 public:
     // Initialise the experiment
     // @param interface the system to evaluate, already instantiated
     // @param stream the list of edges to insert in the system, possibly already permuted
     // @param num_threads the parallelism degree, that is the number of threads to employ to insert concurrently all edges from the stream
-    // @param measure_latency if requested, report the median/min/max/percentiles measured latencies in insertions. Measuring the latency
-    //        could introduce additional overhead and decrease the measure for the overall throughput
     InsertOnly(std::shared_ptr<gfe::library::UpdateInterface> interface, std::shared_ptr<gfe::graph::WeightedEdgeStream> stream, int64_t num_threads);
 
     // Advanced and/or internal parameter, set the granularity of chunks sent by the internal scheduler to the worker threads. The granularity
     // here is given by the number of edge insertions in each chunk.
     void set_scheduler_granularity(uint64_t granularity);
 
+    // Whether to report the median/min/max/percentiles of the latency of the insertions. Measuring the latency could introduce additional
+    // overhead and decrease the measure for the overall throughput
+    void set_measure_latency(bool value);
+
+    // Measure the latency of only one insertion every `sampling' insertions, to reduce the overhead (1 = all insertions)
+    void set_latency_sampling(uint64_t sampling);
+
+    // Set how the edges are distributed among the workers
+    void set_scheduler(InsertionScheduler scheduler);
+
+    // Set how to pin the workers to the logical CPUs
+    void set_worker_placement(ThreadPlacement placement);
+
+    // Set the order in which the edges of the stream are inserted
+    void set_insertion_order(InsertionOrder order);
+
+    // Record the number of edges inserted, the memory footprint and the invocations to #build() in windows of the given length (0 = disabled)
+    void set_timeline_resolution(std::chrono::milliseconds millisecs);
+
+    // Whether to measure the physical or the virtual memory for the memory footprint in the timeline
+    void set_memfp_physical(bool value);
+
     // Set how frequently create a new snapshot/delta in the library (0 = do not create new snapshots)
     void set_build_frequency(std::chrono::milliseconds millisecs);
 
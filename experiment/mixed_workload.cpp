@@ -6,7 +6,7 @@
 
 #include <future>
 #include <chrono>
-#include <unistd.h>
+#include <thread>
 #if defined(HAVE_OPENMP)
   #include "omp.h"
 #endif
@@ -16,87 +16,156 @@
 #include "mixed_workload_result.hpp"
 #include "library/interface.hpp"
 
-#include "common/timer.hpp"
+#include "common/system.hpp"
+#include "common/quantity.hpp"
 
 namespace gfe::experiment {
 
     using namespace std;
     using clock = std::chrono::steady_clock;
 
+    namespace {
+      // Pin the latest epoch for each kernel executed by an analytic client and record the staleness of its snapshot
+      class KernelSnapshots : public GraphalyticsListener {
+        Aging2Experiment& m_aging_experiment; // to retrieve the number of updates performed by the writers
+        details::EpochService* m_epoch_service; // the epochs to pin
+        const uint64_t m_client_id; // the analytic client executing the kernels
+        const clock::time_point m_time_start; // the beginning of the analytics
+        vector<MixedWorkloadKernel>* m_kernels; // where to record the kernels executed
+        const function<bool()>& m_is_done; // whether the analytics should stop, e.g. the deadline of the schedule expired
+        MixedWorkloadKernel m_current; // the kernel being executed
+
+      public:
+        KernelSnapshots(Aging2Experiment& aging_experiment, details::EpochService* epoch_service, uint64_t client_id, clock::time_point time_start, vector<MixedWorkloadKernel>* out_kernels, const function<bool()>& is_done)
+          : m_aging_experiment(aging_experiment), m_epoch_service(epoch_service), m_client_id(client_id), m_time_start(time_start), m_kernels(out_kernels), m_is_done(is_done) { }
+
+        bool on_kernel_start(const char* kernel) override {
+          if(m_is_done()){ return false; } // do not wait for the end of the suite to honour the schedule
+          m_current.m_client = m_client_id;
+          m_current.m_kernel = kernel;
+          auto epoch = m_epoch_service->pin();
+          m_current.m_epoch = epoch.m_epoch;
+          m_current.m_num_updates_epoch = epoch.m_num_operations;
+          m_current.m_time_start = chrono::duration_cast<chrono::milliseconds>(clock::now() - m_time_start).count();
+          m_current.m_num_updates_start = m_aging_experiment.num_operations_sofar();
+          return true;
+        }
+
+        void on_kernel_end(const char* kernel, int64_t completion_time) override {
+          m_current.m_num_updates_end = m_aging_experiment.num_operations_sofar();
+          m_current.m_completion_time = completion_time;
+          m_epoch_service->unpin(m_current.m_epoch);
+          m_kernels->push_back(m_current);
+        }
+      };
+    } // anon namespace
+
     MixedWorkloadResult MixedWorkload::execute() {
+      m_aging_experiment.set_num_reader_threads(m_clients.size()); // reserve a thread_id in the library for each analytic client
       auto aging_result_future = std::async(std::launch::async, &Aging2Experiment::execute, &m_aging_experiment);
-      clock::time_point m_tstart = clock::now();
-      common::Timer timer; timer.start();
-      chrono::seconds progress_check_interval( 1 );
-      this_thread::sleep_for( progress_check_interval );  // Poor mans synchronization to ensure AgingExperiment was able to setup the master etc
-      while (true) {
-        if (m_aging_experiment.progress_so_far() > 0.1 || aging_result_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready) { // The graph reached its final size
-          break;
-        }
-        this_thread::sleep_for( progress_check_interval ) ;
+      const auto time_start = clock::now();
+
+      // warm-up, wait for the signal of the writers, rather than polling
+      bool warmup_done = m_aging_experiment.wait_for_progress(m_schedule.m_warmup_operations, m_schedule.m_warmup_progress);
+      const auto time_warmup_end = clock::now();
+      if(warmup_done){
+        cout << "Warm-up completed in " << common::DurationQuantity(time_warmup_end - time_start) << ", executing graphalytics now" << endl;
+      } else {
+        cout << "The updates terminated before the end of the warm-up, skipping the analytics" << endl;
       }
-      cout << "Graph reached final size, executing graphaltyics now" << endl;
 
-      // TODO change this to also work for LCC, generally this solution is very ugly
+      // partition the read threads among the analytic clients
+      const int num_clients = m_clients.size();
+      int num_threads_per_client = m_read_threads;
 #if defined(HAVE_OPENMP)
-      if(m_read_threads != 0 ){
-                        cout << "[driver] OpenMP, number of threads for the Graphalytics suite: " << m_read_threads << endl;
-                        omp_set_num_threads(m_read_threads);
-                    }
+      if(num_threads_per_client == 0 && num_clients > 1){ num_threads_per_client = omp_get_max_threads(); }
 #endif
-      int i=1; 
-      
+      if(num_clients > 1){ num_threads_per_client = max(1, num_threads_per_client / num_clients); }
 
-      clock::time_point m_t0 = clock::now(); 
-       // start time
-      (m_aging_experiment.m_library)->create_epoch(100+i);
-          cout<<"Current epochs: "<<100+i++<<endl;
-      
-      auto lembda = [&](){
-        clock::time_point m_t0 = clock::now();
-        while(1){
-          clock::time_point m_t1 = clock::now();
-          auto seconds = std::chrono::duration_cast<std::chrono::seconds>(m_t1 - m_t0);
-          long long dur = seconds.count();
-          usleep(500000);
-          (m_aging_experiment.m_library)->run_gc();
-          if(dur > 310)
-            break;
-        }
+      // create the epochs & invoke the garbage collector in background, while the analytics are running
+      details::EpochService epoch_service { m_aging_experiment.m_library, /* do not register the thread */ -1, m_epoch_frequency, m_gc_frequency, m_gc_policy, m_gc_budget, &m_aging_experiment.event_log(),
+          [this](){ return m_aging_experiment.num_operations_sofar(); } };
+      cout << "Current epoch: " << epoch_service.current_epoch() << endl;
+
+      // run the analytic clients
+      vector<vector<MixedWorkloadExecution>> executions (num_clients);
+      vector<vector<MixedWorkloadKernel>> kernels (num_clients);
+      const auto time_analytics_start = clock::now();
+      const uint64_t num_updates_start = m_aging_experiment.num_operations_sofar();
+      const auto time_analytics_end = m_schedule.m_duration > 0ms ? time_analytics_start + m_schedule.m_duration : clock::time_point::max();
+      auto is_done = [&](){ // the stop condition of all analytic clients
+        return !warmup_done || m_clients_done || m_aging_experiment.progress_so_far() >= m_schedule.m_stop_progress || clock::now() >= time_analytics_end ||
+            aging_result_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
       };
-          // lembda();
-          std::thread gcthread(lembda);
-
-      while (m_aging_experiment.progress_so_far() < 0.9 && aging_result_future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
-          clock::time_point m_t1 = clock::now();
-          auto seconds = std::chrono::duration_cast<std::chrono::seconds>(m_t1 - m_t0);
-          long long dur = seconds.count();
-          if(dur > 5){
-            (m_aging_experiment.m_library)->create_epoch(100+i);
-            cout<<"Current epochs: "<<100+i++<<endl;
-            m_t0 = clock::now();
-          }
-          // // // cout<<"\n\n"<<dur<<endl<<endl;
-          // sleep(1);
-          // seconds = std::chrono::duration_cast<std::chrono::seconds>(m_t1 - m_tstart);
-          // dur = seconds.count();
-          // cout<<"time taken till now: "<<timer<<endl;
-          m_graphalytics.execute();
-          // (m_aging_experiment.m_library)->run_gc();
-          // if(i>4) break;
+      m_clients_done = false;
+      vector<thread> clients;
+      for(int client_id = 1; client_id < num_clients && warmup_done; client_id++){
+        clients.emplace_back(&MixedWorkload::execute_client, this, client_id, num_threads_per_client, &epoch_service, time_analytics_start,
+            is_done, &executions[client_id], &kernels[client_id]);
       }
+      execute_client(0, num_threads_per_client, &epoch_service, time_analytics_start, is_done, &executions[0], &kernels[0]);
+      m_clients_done = true; // client 0 may also stop after its iterations
+      for(auto& t : clients){ t.join(); }
+      const auto time_drain_start = clock::now();
+      const uint64_t num_updates_end = m_aging_experiment.num_operations_sofar();
+      const uint64_t num_updates = num_updates_end > num_updates_start ? num_updates_end - num_updates_start : 0;
 
-      cout << "Waiting for aging experiment to finish" << endl;
+      cout << "Draining, waiting for aging experiment to finish" << endl;
       aging_result_future.wait();
+      MixedWorkloadPhases phases;
+      phases.m_warmup = chrono::duration_cast<chrono::microseconds>(time_warmup_end - time_start).count();
+      phases.m_analytics = chrono::duration_cast<chrono::microseconds>(time_drain_start - time_analytics_start).count();
+      phases.m_drain = chrono::duration_cast<chrono::microseconds>(clock::now() - time_drain_start).count();
       cout << "Getting aging experiment results" << endl;
       auto aging_result = aging_result_future.get();
       // sleep(20);
       // (m_aging_experiment.m_library)->create_epoch(100+i+1);
       // m_graphalytics.execute();
-      m_graphalytics.report(false);
-      gcthread.join();
-      return MixedWorkloadResult { aging_result, m_graphalytics };
+      epoch_service.stop();
+      cout << "Epochs created: " << epoch_service.statistics().m_epochs.size() << endl;
+      vector<MixedWorkloadExecution> all_executions;
+      for(auto& e : executions){ all_executions.insert(all_executions.end(), e.begin(), e.end()); }
+      vector<MixedWorkloadKernel> all_kernels;
+      for(auto& k : kernels){ all_kernels.insert(all_kernels.end(), k.begin(), k.end()); }
+      return MixedWorkloadResult { aging_result, m_clients, epoch_service.statistics(), all_executions, all_kernels, (uint64_t) num_threads_per_client, phases, num_updates };
       
     }
 
-}
\ No newline at end of file
+    void MixedWorkload::execute_client(uint64_t client_id, int num_threads, details::EpochService* epoch_service, clock::time_point time_start,
+        const std::function<bool()>& is_done, std::vector<MixedWorkloadExecution>* out_executions, std::vector<MixedWorkloadKernel>* out_kernels) {
+      if(client_id > 0){
+        common::concurrency::set_thread_name("Analytics #" + to_string(client_id));
+      }
+#if defined(HAVE_OPENMP)
+      if(num_threads != 0){ // the number of threads of OpenMP is a property of the thread starting the parallel region
+        cout << "[driver] OpenMP, analytic client #" << client_id << ", number of threads for the Graphalytics suite: " << num_threads << endl;
+        omp_set_num_threads(num_threads);
+      }
+#endif
+
+      // each client has its own thread_id, so that the snapshots of the concurrent kernels are tracked independently
+      const int thread_id = m_aging_experiment.reader_thread_id(client_id);
+      m_aging_experiment.m_library->on_thread_init(thread_id);
+
+      KernelSnapshots snapshots { m_aging_experiment, epoch_service, client_id, time_start, out_kernels, is_done };
+      m_clients[client_id]->set_listener(&snapshots);
+
+      while (!is_done() && (m_schedule.m_iterations == 0 || out_executions->size() < m_schedule.m_iterations)) {
+          uint64_t epoch = epoch_service->current_epoch();
+          uint64_t num_updates_start = m_aging_experiment.num_operations_sofar();
+          auto t0 = clock::now();
+          m_clients[client_id]->execute();
+          auto t1 = clock::now();
+          uint64_t num_updates_end = m_aging_experiment.num_operations_sofar();
+
+          out_executions->push_back(MixedWorkloadExecution{ client_id, epoch,
+            static_cast<uint64_t>( chrono::duration_cast<chrono::milliseconds>(t0 - time_start).count() ),
+            static_cast<uint64_t>( chrono::duration_cast<chrono::microseconds>(t1 - t0).count() ),
+            num_updates_end > num_updates_start ? num_updates_end - num_updates_start : 0 });
+      }
+
+      m_clients[client_id]->set_listener(nullptr);
+      m_aging_experiment.m_library->on_thread_destroy(thread_id);
+    }
+
+}
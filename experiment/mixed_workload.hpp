@@ -1,23 +1,76 @@
 #ifndef GFE_DRIVER_MIXED_WORKLOAD_H
 #define GFE_DRIVER_MIXED_WORKLOAD_H
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "details/epoch_service.hpp"
+
 namespace gfe::experiment { class Aging2Experiment; }
 namespace gfe::experiment { class GraphalyticsSequential; }
 namespace gfe::experiment { class MixedWorkloadResult; }
+namespace gfe::experiment { struct MixedWorkloadExecution; }
+namespace gfe::experiment { struct MixedWorkloadKernel; }
 
 namespace gfe::experiment {
 
+    /**
+     * The phases of the mixed workload: warm-up (updates only), analytics (updates & analytics concurrently), drain (the
+     * remaining updates only). The analytics start once the warm-up target is reached, and stop as soon as any of the
+     * limits set is reached, or the writers completed all updates.
+     */
+    struct MixedWorkloadSchedule {
+        uint64_t m_warmup_operations = 0; // start the analytics once the writers performed at least this number of updates
+        double m_warmup_progress = 0.1; // ... and at least this fraction of all updates
+        std::chrono::milliseconds m_duration { 0 }; // stop the analytics after the given amount of time, checked before each kernel (0 = no limit)
+        uint64_t m_iterations = 0; // stop each analytic client after the given number of executions of the Graphalytics suite (0 = no limit)
+        double m_stop_progress = 0.9; // stop the analytics once the writers performed this fraction of all updates
+    };
+
     class MixedWorkload {
     public:
         MixedWorkload(Aging2Experiment& aging_experiment, GraphalyticsSequential& graphalytics, int read_threads)
-          : m_aging_experiment(aging_experiment), m_graphalytics(graphalytics), m_read_threads(read_threads) {}
+          : m_aging_experiment(aging_experiment), m_clients{ &graphalytics }, m_read_threads(read_threads) {}
+
+        // Add another analytic client, running the Graphalytics suite concurrently to the other clients. The read threads are
+        // partitioned among the clients. The given instance must outlive the experiment.
+        void add_client(GraphalyticsSequential& graphalytics){ m_clients.push_back(&graphalytics); }
+
+        // How frequently to create a new epoch in the library, while the analytics are running
+        void set_epoch_frequency(std::chrono::milliseconds frequency){ m_epoch_frequency = frequency; }
+
+        // How frequently to invoke the garbage collector of the library, with the policy `periodic'
+        void set_gc_frequency(std::chrono::milliseconds frequency){ m_gc_frequency = frequency; }
+
+        // When to invoke the garbage collector of the library
+        void set_gc_policy(details::GCPolicy policy){ m_gc_policy = policy; }
+
+        // The max amount of time for each invocation to the garbage collector of the library (0 = unbounded)
+        void set_gc_budget(std::chrono::microseconds budget){ m_gc_budget = budget; }
+
+        // Set the phases of the experiment
+        void set_schedule(const MixedWorkloadSchedule& schedule){ m_schedule = schedule; }
 
         MixedWorkloadResult execute();
     private:
         Aging2Experiment& m_aging_experiment;
-        GraphalyticsSequential& m_graphalytics;
+        std::vector<GraphalyticsSequential*> m_clients; // the analytic clients, the first one runs in the thread invoking #execute
+        std::atomic<bool> m_clients_done = false; // signal the other analytic clients to stop
 
         int m_read_threads = 0;
+        std::chrono::milliseconds m_epoch_frequency { 5000 }; // how frequently to create a new epoch
+        std::chrono::milliseconds m_gc_frequency { 500 }; // how frequently to invoke the garbage collector
+        details::GCPolicy m_gc_policy = details::GCPolicy::PERIODIC; // when to invoke the garbage collector
+        std::chrono::microseconds m_gc_budget { 0 }; // the max time for each invocation to the garbage collector, 0 = unbounded
+        MixedWorkloadSchedule m_schedule; // the phases of the experiment
+
+        // Run the Graphalytics suite with the given client, until is_done() returns true or the client completed the number of
+        // iterations in the schedule. Each kernel pins the latest epoch from the epoch service.
+        void execute_client(uint64_t client_id, int num_threads, details::EpochService* epoch_service, std::chrono::steady_clock::time_point time_start,
+                const std::function<bool()>& is_done, std::vector<MixedWorkloadExecution>* out_executions, std::vector<MixedWorkloadKernel>* out_kernels);
     };
 
 }
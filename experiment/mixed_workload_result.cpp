@@ -4,22 +4,91 @@
 
 #include "mixed_workload_result.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
 #include "common/database.hpp"
+#include "common/quantity.hpp"
 #include "aging2_result.hpp"
 #include "graphalytics.hpp"
 #include "iostream"
 
 namespace gfe::experiment {
+    using namespace common;
     using namespace std;
 
-    MixedWorkloadResult::MixedWorkloadResult(Aging2Result aging_result, GraphalyticsSequential& analytics)
-      : m_aging_result(aging_result), m_graphalytics(analytics) {
+    MixedWorkloadResult::MixedWorkloadResult(Aging2Result aging_result, const vector<GraphalyticsSequential*>& analytics, const details::EpochStatistics& epochs,
+        const vector<MixedWorkloadExecution>& executions, const vector<MixedWorkloadKernel>& kernels, uint64_t num_threads_per_client, const MixedWorkloadPhases& phases, uint64_t num_updates)
+      : m_aging_result(aging_result), m_clients(analytics), m_executions(executions), m_kernels(kernels), m_num_threads_per_client(num_threads_per_client),
+        m_phases(phases), m_num_updates(num_updates), m_epochs(epochs) {
 
     }
 
     void MixedWorkloadResult::save(common::Database* db) {
       cout << "Start saving results" << endl;
-      m_graphalytics.report(false);
+      for(auto client : m_clients){ client->report(false); }
+
+      // per client latency
+      for(uint64_t client_id = 0; client_id < m_clients.size(); client_id++){
+        uint64_t num_executions = 0, sum = 0, min = numeric_limits<uint64_t>::max(), max = 0;
+        for(const auto& e : m_executions){
+          if(e.m_client != client_id) continue;
+          num_executions++;
+          sum += e.m_completion_time;
+          min = std::min(min, e.m_completion_time);
+          max = std::max(max, e.m_completion_time);
+        }
+        if(num_executions == 0){
+          cout << "Analytic client #" << client_id << ", no executions completed" << endl;
+        } else {
+          cout << "Analytic client #" << client_id << ", executions: " << num_executions << ", completion time, avg: " << DurationQuantity(chrono::microseconds(sum / num_executions)) << ", "
+              "min: " << DurationQuantity(chrono::microseconds(min)) << ", max: " << DurationQuantity(chrono::microseconds(max)) << endl;
+        }
+      }
+
+      // analytics throughput alongside the writers throughput
+      const uint64_t duration = m_phases.m_analytics;
+      const uint64_t analytics_per_hour = duration > 0 ? m_executions.size() * 3600ull * 1000000ull / duration : 0ull;
+      const uint64_t updates_per_sec = duration > 0 ? m_num_updates * 1000000ull / duration : 0ull;
+      cout << "Phases, warm-up: " << DurationQuantity(chrono::microseconds(m_phases.m_warmup)) << ", analytics: " << DurationQuantity(chrono::microseconds(duration)) << ", "
+          "drain: " << DurationQuantity(chrono::microseconds(m_phases.m_drain)) << endl;
+      cout << "Analytic clients: " << m_clients.size() << ", executions per hour: " << analytics_per_hour << ", updates per second: " << updates_per_sec << endl;
+
+      if(db == nullptr) return;
+      m_epochs.save(db);
+      for(const auto& e : m_executions){
+        auto store = db->add("mixed_workload_analytics");
+        store.add("client", e.m_client);
+        store.add("epoch", e.m_epoch);
+        store.add("time_start", e.m_time_start); // millisecs
+        store.add("completion_time", e.m_completion_time); // microsecs
+        store.add("num_updates", e.m_num_updates);
+      }
+
+      for(const auto& k : m_kernels){
+        auto store = db->add("mixed_workload_kernels");
+        store.add("client", k.m_client);
+        store.add("kernel", k.m_kernel);
+        store.add("epoch", k.m_epoch);
+        store.add("time_start", k.m_time_start); // millisecs
+        store.add("completion_time", k.m_completion_time); // microsecs, -1 => timeout
+        store.add("num_updates_epoch", k.m_num_updates_epoch); // updates performed when the pinned epoch was created
+        store.add("num_updates_start", k.m_num_updates_start); // updates performed when the snapshot was acquired
+        store.add("num_updates_end", k.m_num_updates_end); // updates performed when the kernel completed
+        store.add("staleness", k.m_num_updates_end > k.m_num_updates_epoch ? k.m_num_updates_end - k.m_num_updates_epoch : 0ull); // updates not visible to the kernel by its completion
+      }
+
+      auto store = db->add("mixed_workload");
+      store.add("num_clients", (uint64_t) m_clients.size());
+      store.add("num_threads_per_client", m_num_threads_per_client);
+      store.add("warmup", m_phases.m_warmup); // microsecs
+      store.add("duration", m_phases.m_analytics); // microsecs
+      store.add("drain", m_phases.m_drain); // microsecs
+      store.add("num_executions", (uint64_t) m_executions.size());
+      store.add("num_updates", m_num_updates);
+      store.add("executions_per_hour", analytics_per_hour);
+      store.add("updates_per_sec", updates_per_sec);
       // cout << "Saved graphalytics" << endl;
       // m_aging_result.save(db);
       // cout << "Saved aging" << endl;
@@ -1,21 +1,62 @@
 #ifndef GFE_DRIVER_MIXED_WORKLOAD_RESULT_H
 #define GFE_DRIVER_MIXED_WORKLOAD_RESULT_H
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 #include "aging2_result.hpp"
+#include "details/epoch_service.hpp"
 namespace gfe::experiment { class GraphalyticsSequential; }
 namespace common { class Database; }
 
 namespace gfe::experiment {
 
+    // A single execution of the Graphalytics suite by an analytic client
+    struct MixedWorkloadExecution {
+        uint64_t m_client; // the client that executed the suite, 0-based
+        uint64_t m_epoch; // the latest epoch when the execution started, each kernel pins its own epoch
+        uint64_t m_time_start; // when the execution started, in millisecs since the beginning of the analytics
+        uint64_t m_completion_time; // the time to execute the whole suite, in microsecs
+        uint64_t m_num_updates; // number of updates performed by the writers while the suite was running
+    };
+
+    // A single kernel of the Graphalytics suite executed by an analytic client, with the staleness of its snapshot
+    struct MixedWorkloadKernel {
+        uint64_t m_client; // the client that executed the kernel, 0-based
+        std::string m_kernel; // bfs, cdlp, lcc, pagerank, sssp or wcc
+        uint64_t m_epoch; // the epoch pinned for the kernel
+        uint64_t m_time_start; // when the snapshot was acquired, in millisecs since the beginning of the analytics
+        int64_t m_completion_time; // the execution time of the kernel, in microsecs (-1 = timeout)
+        uint64_t m_num_updates_epoch; // number of updates performed by the writers when the pinned epoch was created
+        uint64_t m_num_updates_start; // number of updates performed by the writers when the snapshot was acquired
+        uint64_t m_num_updates_end; // number of updates performed by the writers when the kernel completed
+    };
+
+    // The length of each phase of the mixed workload, in microsecs
+    struct MixedWorkloadPhases {
+        uint64_t m_warmup = 0; // updates only, before the analytics started
+        uint64_t m_analytics = 0; // updates & analytics concurrently
+        uint64_t m_drain = 0; // updates only, after the analytics completed
+    };
+
     class MixedWorkloadResult {
     public:
-        MixedWorkloadResult(Aging2Result aging_result, GraphalyticsSequential& analytics);
+        MixedWorkloadResult(Aging2Result aging_result, const std::vector<GraphalyticsSequential*>& analytics, const details::EpochStatistics& epochs,
+            const std::vector<MixedWorkloadExecution>& executions, const std::vector<MixedWorkloadKernel>& kernels, uint64_t num_threads_per_client,
+            const MixedWorkloadPhases& phases, uint64_t num_updates);
 
         void save(common::Database* db);
 
     private:
         Aging2Result m_aging_result;
-        GraphalyticsSequential& m_graphalytics;
+        std::vector<GraphalyticsSequential*> m_clients; // the analytic clients
+        std::vector<MixedWorkloadExecution> m_executions; // all executions of the Graphalytics suite, from all clients
+        std::vector<MixedWorkloadKernel> m_kernels; // all kernels executed, from all clients
+        uint64_t m_num_threads_per_client; // the number of OpenMP threads assigned to each client (0 = OpenMP default)
+        MixedWorkloadPhases m_phases; // how long each phase of the experiment lasted
+        uint64_t m_num_updates; // number of updates performed by the writers while the analytic clients were running
+        details::EpochStatistics m_epochs; // the epochs created & the invocations to the garbage collector
     };
 
 }
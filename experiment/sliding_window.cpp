@@ -0,0 +1,365 @@
+/**
+ * Copyright (C) 2019 Dean De Leo, email: dleo[at]cwi.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "sliding_window.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+#include "common/database.hpp"
+#include "common/quantity.hpp"
+#include "common/system.hpp"
+#include "common/timer.hpp"
+#include "details/build_thread.hpp"
+#include "details/epoch_service.hpp"
+#include "graph/edge.hpp"
+#include "graph/edge_stream.hpp"
+#include "library/interface.hpp"
+#include "utility/memory_usage.hpp"
+#include "configuration.hpp"
+
+using namespace common;
+using namespace gfe::experiment::details;
+using namespace std;
+
+/*****************************************************************************
+ *                                                                           *
+ * Debug                                                                     *
+ *                                                                           *
+ *****************************************************************************/
+extern mutex _log_mutex [[maybe_unused]];
+//#define DEBUG
+#define COUT_DEBUG_FORCE(msg) { scoped_lock<mutex> lock(_log_mutex); cout << "[SlidingWindow::" << __FUNCTION__ << "] [" << concurrency::get_thread_id() << "] " << msg << endl; }
+#if defined(DEBUG)
+    #define COUT_DEBUG(msg) COUT_DEBUG_FORCE(msg)
+#else
+    #define COUT_DEBUG(msg)
+#endif
+
+namespace gfe::experiment {
+
+/*****************************************************************************
+ *                                                                           *
+ * Init                                                                      *
+ *                                                                           *
+ *****************************************************************************/
+SlidingWindow::SlidingWindow(std::shared_ptr<gfe::library::UpdateInterface> interface, std::shared_ptr<gfe::graph::WeightedEdgeStream> stream, int64_t num_threads, uint64_t window_size) :
+        m_interface(interface), m_stream(stream), m_num_threads(num_threads), m_window_size(window_size) {
+    if(m_num_threads <= 0) INVALID_ARGUMENT("Invalid number of threads: " << m_num_threads);
+    if(m_window_size == 0) INVALID_ARGUMENT("The size of the window cannot be zero");
+    if(m_window_size >= m_stream->num_edges()) INVALID_ARGUMENT("The size of the window (" << m_window_size << ") must be smaller than the number of edges in the stream (" << m_stream->num_edges() << ")");
+}
+
+SlidingWindow::~SlidingWindow(){ }
+
+void SlidingWindow::set_num_passes(uint64_t value){
+    if(value == 0) INVALID_ARGUMENT("The number of passes cannot be zero");
+    m_num_passes = value;
+}
+
+void SlidingWindow::set_build_frequency(std::chrono::milliseconds millisecs){
+    m_build_frequency = millisecs;
+}
+
+void SlidingWindow::set_gc_frequency(std::chrono::milliseconds millisecs){
+    m_gc_frequency = millisecs;
+}
+
+void SlidingWindow::set_report_interval(std::chrono::milliseconds millisecs){
+    if(millisecs.count() <= 0) INVALID_ARGUMENT("The report interval must be positive: " << millisecs.count() << " ms");
+    m_report_interval = millisecs;
+}
+
+void SlidingWindow::set_timeout(std::chrono::seconds secs){
+    m_timeout = secs;
+}
+
+void SlidingWindow::set_memfp_physical(bool value){
+    m_memfp_physical = value;
+}
+
+void SlidingWindow::set_report_progress(bool value){
+    m_report_progress = value;
+}
+
+/*****************************************************************************
+ *                                                                           *
+ * Workers                                                                   *
+ *                                                                           *
+ *****************************************************************************/
+// the key used to partition the edges, undirected edges are normalised so that both directions map to the same worker
+static graph::Edge edge_key(graph::Edge edge, bool is_directed){
+    if(!is_directed && edge.source() > edge.destination()) edge.swap_src_dst();
+    return edge;
+}
+
+void SlidingWindow::partition_stream(){
+    const graph::WeightedEdgeStream* stream = m_stream.get();
+    const bool is_directed = m_interface->is_directed();
+
+    // the edges are partitioned by their hash, so that both the insertion & the deletion of an edge are performed by the same worker
+    m_partitions.clear();
+    m_partitions.resize(m_num_threads);
+    for(uint64_t i = 0, sz = stream->num_edges(); i < sz; i++){
+        graph::Edge key = edge_key(stream->get(i).edge(), is_directed);
+        m_partitions[ hash<graph::Edge>{}(key) % m_num_threads ].push_back(i);
+    }
+}
+
+void SlidingWindow::main_worker(int worker_id){
+    concurrency::set_thread_name("Worker #" + to_string(worker_id));
+    COUT_DEBUG("worker_id: " << worker_id);
+
+    auto interface = m_interface.get();
+    const graph::WeightedEdgeStream* stream = m_stream.get();
+    const uint64_t stream_sz = stream->num_edges();
+    const vector<uint64_t>& positions = m_partitions[worker_id]; // the positions in the stream of the edges of this worker
+    const uint64_t num_positions = positions.size();
+    const bool is_directed = interface->is_directed();
+    WorkerCounters& counters = m_counters[worker_id];
+    unordered_map<graph::Edge, uint32_t> live_edges; // the edges of this worker in the window, with their number of occurrences
+    uint64_t num_insertions = 0, num_deletions = 0, num_steady_ops = 0, num_failures = 0;
+    uint64_t num_ops_since_publish = 0;
+    bool window_filled = false;
+
+    interface->on_thread_init(worker_id);
+
+    // the simulated time of the i-th edge processed by this worker, one edge per position of the stream, across all passes
+    auto time_of = [&](uint64_t i){ return (i / num_positions) * stream_sz + positions[i % num_positions]; };
+
+    // remove the edges of this worker that left the window at the given time
+    uint64_t expire = 0; // the next edge of this worker to expire, in the same sequence of #time_of
+    uint64_t next = 0; // the next edge of this worker to insert, in the same sequence of #time_of
+    auto expire_until = [&](uint64_t time){
+        while(expire < next && time_of(expire) + m_window_size <= time){
+            graph::WeightedEdge expired = stream->get(positions[expire % num_positions]);
+            graph::Edge expired_key = edge_key(expired.edge(), is_directed);
+            auto it = live_edges.find(expired_key);
+            assert(it != live_edges.end() && "The edge should be in the window");
+            if(--(it->second) == 0){ // last occurrence
+                live_edges.erase(it);
+                if(interface->remove_edge(expired.edge())){ num_deletions++; } else { num_failures++; }
+                num_steady_ops++;
+                num_ops_since_publish++;
+            }
+            expire++;
+        }
+    };
+
+    for(uint64_t pass = 0; pass < m_num_passes && !m_stop; pass++){
+        for(uint64_t j = 0; j < num_positions && !m_stop; j++, next++){
+            const uint64_t time = time_of(next);
+            graph::WeightedEdge edge = stream->get(positions[j]);
+            graph::Edge key = edge_key(edge.edge(), is_directed);
+
+            if(!window_filled && time >= m_window_size){
+                window_filled = true;
+                counters.m_time_window_filled = elapsed_microsecs();
+            }
+
+            expire_until(time);
+
+            // insert the new edge
+            if(live_edges[key]++ == 0){ // first occurrence in the window
+                if(interface->add_edge_v2(edge)){ num_insertions++; } else { num_failures++; }
+                if(window_filled) num_steady_ops++;
+                num_ops_since_publish++;
+            }
+
+            // publish the progress to the master
+            if(num_ops_since_publish >= 1024){
+                counters.m_num_insertions.store(num_insertions, memory_order_relaxed);
+                counters.m_num_deletions.store(num_deletions, memory_order_relaxed);
+                counters.m_num_steady_ops.store(num_steady_ops, memory_order_relaxed);
+                num_ops_since_publish = 0;
+            }
+        }
+
+        // at the end of the pass, the window of this worker contains only its edges among the last `window size' of the stream
+        if(!m_stop){ expire_until((pass +1) * stream_sz -1); }
+    }
+
+    if(!window_filled){ counters.m_time_window_filled = elapsed_microsecs(); } // interrupted by the timeout
+    counters.m_num_insertions = num_insertions;
+    counters.m_num_deletions = num_deletions;
+    counters.m_num_steady_ops = num_steady_ops;
+    counters.m_num_failures = num_failures;
+
+    interface->on_thread_destroy(worker_id);
+    m_num_workers_done++;
+}
+
+/*****************************************************************************
+ *                                                                           *
+ * Experiment                                                                *
+ *                                                                           *
+ *****************************************************************************/
+uint64_t SlidingWindow::elapsed_microsecs() const {
+    return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - m_time_start).count();
+}
+
+uint64_t SlidingWindow::memory_footprint() const {
+    return m_memfp_physical ? common::get_memory_footprint() : max<int64_t>(utility::MemoryUsage::memory_footprint(), 0);
+}
+
+void SlidingWindow::wait_and_record(vector<thread>& workers){
+    auto record_sample = [this](){
+        ProgressSample sample { elapsed_microsecs() / 1000, 0, 0, memory_footprint() };
+        for(int64_t i = 0; i < m_num_threads; i++){
+            sample.m_num_insertions += m_counters[i].m_num_insertions.load(memory_order_relaxed);
+            sample.m_num_deletions += m_counters[i].m_num_deletions.load(memory_order_relaxed);
+        }
+        m_progress.push_back(sample);
+
+        if(m_report_progress){
+            LOG("[SlidingWindow] Progress: " << DurationQuantity(sample.m_time * 1000000) << ", insertions: " << sample.m_num_insertions << ", "
+                    "deletions: " << sample.m_num_deletions << ", memory footprint: " << ComputerQuantity(sample.m_memfp_process, true));
+        }
+    };
+
+    auto next_sample = m_time_start + m_report_interval;
+    while(m_num_workers_done < m_num_threads){
+        this_thread::sleep_for(10ms);
+        auto now = chrono::steady_clock::now();
+
+        if(m_timeout.count() > 0 && now >= m_time_start + m_timeout && !m_stop){
+            LOG("[SlidingWindow] Timeout hit, stopping the workers ...");
+            m_timeout_hit = true;
+            m_stop = true;
+        }
+
+        if(now >= next_sample){
+            record_sample();
+            next_sample += m_report_interval;
+        }
+    }
+
+    for(auto& t: workers) t.join();
+    record_sample(); // final state
+}
+
+chrono::microseconds SlidingWindow::execute() {
+    LOG("[SlidingWindow] Streaming " << m_stream->num_edges() << " edges x " << m_num_passes << " passes through a window of " << m_window_size << " edges, "
+            "threads: " << m_num_threads);
+
+    partition_stream();
+    m_counters.reset( new WorkerCounters[m_num_threads] );
+    m_stop = false;
+    m_num_workers_done = 0;
+
+    m_interface->on_main_init(m_num_threads + /* build & gc services */ 2);
+    m_interface->updates_start();
+    m_time_start = chrono::steady_clock::now();
+    Timer timer; timer.start();
+    BuildThread build_service { m_interface , static_cast<int>(m_num_threads), m_build_frequency, &m_event_log };
+    unique_ptr<EpochService> gc_service; // invoke the garbage collector periodically, if enabled
+    if(m_gc_frequency.count() > 0){
+        gc_service.reset( new EpochService{ m_interface, static_cast<int>(m_num_threads) +1, /* no periodic epochs */ 0ms, m_gc_frequency, GCPolicy::PERIODIC, /* unbounded */ 0us, &m_event_log } );
+    }
+
+    vector<thread> workers;
+    for(int64_t i = 0; i < m_num_threads; i++){ workers.emplace_back(&SlidingWindow::main_worker, this, static_cast<int>(i)); }
+    wait_and_record(workers);
+
+    build_service.stop();
+    if(gc_service){ gc_service->stop(); }
+    m_interface->updates_stop();
+
+    // a final invocation of the method #build()
+    m_interface->on_thread_init(0);
+    auto t0 = chrono::steady_clock::now();
+    m_interface->build();
+    m_event_log.record(EventLog::Type::BUILD, t0, chrono::steady_clock::now());
+    timer.stop();
+    m_completion_time = timer.microseconds();
+    m_num_build_invocations = build_service.num_invocations() +1;
+    m_num_edges_final = m_interface->num_edges();
+    m_interface->on_thread_destroy(0);
+    m_interface->on_main_destroy();
+
+    // aggregate the counters of the workers
+    m_num_insertions = m_num_deletions = m_num_steady_ops = m_num_failures = m_time_window_filled = 0;
+    for(int64_t i = 0; i < m_num_threads; i++){
+        m_num_insertions += m_counters[i].m_num_insertions;
+        m_num_deletions += m_counters[i].m_num_deletions;
+        m_num_steady_ops += m_counters[i].m_num_steady_ops;
+        m_num_failures += m_counters[i].m_num_failures;
+        m_time_window_filled = max<uint64_t>(m_time_window_filled, m_counters[i].m_time_window_filled);
+    }
+    m_counters.reset();
+    m_partitions.clear();
+
+    LOG("[SlidingWindow] Experiment completed in " << timer << ", insertions: " << m_num_insertions << ", deletions: " << m_num_deletions << ", "
+            "failures: " << m_num_failures << ", window filled after: " << DurationQuantity(m_time_window_filled * 1000));
+    if(m_completion_time > m_time_window_filled){
+        LOG("[SlidingWindow] Steady state throughput: " << m_num_steady_ops * 1000000ull / (m_completion_time - m_time_window_filled) << " updates/sec");
+    }
+    LOG("[SlidingWindow] Edges in the window: " << m_num_insertions - m_num_deletions << ", num edges stored in the graph: " << m_num_edges_final << ", "
+            "match: " << (m_num_insertions - m_num_deletions == m_num_edges_final ? "yes" : "no"));
+
+    return chrono::microseconds{ m_completion_time };
+}
+
+void SlidingWindow::save() {
+    assert(configuration().db() != nullptr);
+
+    // garbage collection
+    uint64_t num_gc = 0, time_gc = 0, max_pause_gc = 0;
+    for(const auto& event : m_event_log.events()){
+        if(event.m_type != EventLog::Type::GC) continue;
+        uint64_t duration = chrono::duration_cast<chrono::microseconds>(event.m_end - event.m_start).count();
+        num_gc++;
+        time_gc += duration;
+        max_pause_gc = max(max_pause_gc, duration);
+    }
+    uint64_t memfp_max = 0;
+    for(const auto& sample : m_progress){ memfp_max = max(memfp_max, sample.m_memfp_process); }
+    const uint64_t steady_time = m_completion_time > m_time_window_filled ? m_completion_time - m_time_window_filled : 0;
+
+    auto db = configuration().db()->add("sliding_window");
+    db.add("num_threads", (uint64_t) m_num_threads);
+    db.add("window_size", m_window_size); // number of edges
+    db.add("num_passes", m_num_passes);
+    db.add("stream_size", m_stream->num_edges());
+    db.add("completion_time", m_completion_time); // microseconds
+    db.add("window_filled_time", m_time_window_filled); // microseconds
+    db.add("num_insertions", m_num_insertions);
+    db.add("num_deletions", m_num_deletions);
+    db.add("num_failures", m_num_failures);
+    db.add("num_steady_updates", m_num_steady_ops);
+    db.add("steady_throughput", steady_time > 0 ? m_num_steady_ops * 1000000ull / steady_time : 0ull); // updates/sec
+    db.add("num_edges_final", m_num_edges_final);
+    db.add("num_build_invocations", m_num_build_invocations);
+    db.add("num_gc_invocations", num_gc);
+    db.add("gc_time", time_gc); // microseconds
+    db.add("gc_max_pause", max_pause_gc); // microseconds
+    db.add("memfp_max", memfp_max); // bytes
+    db.add("has_terminated_for_timeout", (int64_t) m_timeout_hit);
+
+    for(const auto& sample : m_progress){
+        auto db = configuration().db()->add("sliding_window_progress");
+        db.add("time", sample.m_time); // millisecs
+        db.add("num_insertions", sample.m_num_insertions);
+        db.add("num_deletions", sample.m_num_deletions);
+        db.add("memfp_process", sample.m_memfp_process); // bytes
+    }
+}
+
+} // namespace
@@ -0,0 +1,162 @@
+/**
+ * Copyright (C) 2019 Dean De Leo, email: dleo[at]cwi.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "details/event_log.hpp"
+
+namespace gfe::graph { class WeightedEdgeStream; } // forward decl.
+namespace gfe::library { class UpdateInterface; } // forward decl.
+
+namespace gfe::experiment {
+
+/**
+ * Stream a time-ordered sequence of edges through a window of fixed size. Once the window is full, each insertion of a
+ * new edge is paired with the deletion of the edge that was inserted `window size' edges earlier, so that the graph
+ * only retains the most recent edges of the stream. The stream can be replayed multiple times, to simulate a longer
+ * period of time.
+ *
+ * The edges are partitioned among the worker threads by their hash, so that the insertion and the deletion of the same
+ * edge are always performed by the same worker, in the order of the stream. Repeated edges inside the window are
+ * inserted only once and removed when their last occurrence expires.
+ *
+ * Each worker maintains the slice of the window made of its own edges and advances it independently of the other
+ * workers: when it inserts the edge at position t of the stream, it removes its edges at the positions up to
+ * t - `window size'. As the workers are not synchronised, the overall window is only approximately of `window size'
+ * edges while the stream is replayed. At the end of each pass, every worker also removes its edges preceding the last
+ * `window size' positions of the stream, so that, once all workers completed the pass, the graph contains exactly the
+ * distinct edges among the last `window size' of the stream.
+ *
+ * The experiment reports the throughput in the steady state, that is after the window has been filled, together with
+ * the memory footprint over time and the invocations to the garbage collector.
+ */
+class SlidingWindow {
+    SlidingWindow(const SlidingWindow&) = delete;
+    SlidingWindow& operator=(const SlidingWindow&) = delete;
+
+    // The counters of each worker, padded to avoid false sharing among the workers
+    struct alignas(64) WorkerCounters {
+        std::atomic<uint64_t> m_num_insertions = 0; // number of edges inserted so far
+        std::atomic<uint64_t> m_num_deletions = 0; // number of edges removed so far
+        std::atomic<uint64_t> m_num_steady_ops = 0; // number of insertions & deletions performed after the window has been filled
+        std::atomic<uint64_t> m_time_window_filled = 0; // when the worker reached the end of the window, in microsecs since the start of the experiment
+        uint64_t m_num_failures = 0; // number of insertions/deletions rejected by the library
+    };
+
+    // A single sample of the progress of the experiment
+    struct ProgressSample {
+        uint64_t m_time; // when the sample was taken, in millisecs since the start of the experiment
+        uint64_t m_num_insertions; // total number of insertions performed so far
+        uint64_t m_num_deletions; // total number of deletions performed so far
+        uint64_t m_memfp_process; // the memory footprint of the whole process, in bytes
+    };
+
+    std::shared_ptr<gfe::library::UpdateInterface> m_interface; // the library to evaluate
+    std::shared_ptr<gfe::graph::WeightedEdgeStream> m_stream; // the edges to stream, sorted by time
+    const int64_t m_num_threads; // the number of worker threads
+    const uint64_t m_window_size; // the number of edges in the window
+    uint64_t m_num_passes = 1; // how many times to replay the stream
+    std::chrono::milliseconds m_build_frequency {0}; // how frequently to invoke the method #build() (0 = disabled)
+    std::chrono::milliseconds m_gc_frequency {0}; // how frequently to invoke the garbage collector of the library (0 = disabled)
+    std::chrono::milliseconds m_report_interval {1000}; // how often to sample the progress of the experiment
+    std::chrono::seconds m_timeout {0}; // max time to run the experiment (0 = no limit)
+    bool m_memfp_physical = false; // whether to measure the physical or the virtual memory in the memory footprint
+    bool m_report_progress = false; // whether to print to stdout the progress of the experiment
+
+    std::vector<std::vector<uint64_t>> m_partitions; // the positions in the stream of the edges assigned to each worker
+    std::unique_ptr<WorkerCounters[]> m_counters; // the counters of each worker
+    std::atomic<bool> m_stop = false; // signal the workers to stop, due to the timeout
+    std::atomic<int64_t> m_num_workers_done = 0; // number of workers that completed their part of the stream
+    std::chrono::steady_clock::time_point m_time_start; // when the experiment started
+    details::EventLog m_event_log; // builds & garbage collections occurred during the experiment
+
+    // results
+    uint64_t m_completion_time = 0; // the time to stream all edges, in microsecs
+    uint64_t m_time_window_filled = 0; // when all workers filled their window, in microsecs since the start
+    uint64_t m_num_insertions = 0; // total number of insertions performed
+    uint64_t m_num_deletions = 0; // total number of deletions performed
+    uint64_t m_num_steady_ops = 0; // total number of updates performed after the window has been filled
+    uint64_t m_num_failures = 0; // total number of updates rejected by the library
+    uint64_t m_num_build_invocations = 0; // total number of invocations to #build()
+    uint64_t m_num_edges_final = 0; // number of edges stored in the library at the end of the experiment
+    bool m_timeout_hit = false; // whether the experiment has been stopped due to the timeout
+    std::vector<ProgressSample> m_progress; // the progress of the experiment over time
+
+    // Assign the edges of the stream to the workers
+    void partition_stream();
+
+    // The logic of each worker thread
+    void main_worker(int worker_id);
+
+    // Sample the progress of the workers until they complete
+    void wait_and_record(std::vector<std::thread>& workers);
+
+    // Retrieve the current memory footprint of the process
+    uint64_t memory_footprint() const;
+
+    // Time elapsed since the start of the experiment
+    uint64_t elapsed_microsecs() const;
+
+public:
+    /**
+     * Initialise the experiment
+     * @param interface the library to evaluate, it should be empty
+     * @param stream the edges to stream, sorted by time
+     * @param num_threads the number of worker threads
+     * @param window_size the number of edges retained in the window, it must be smaller than the stream
+     */
+    SlidingWindow(std::shared_ptr<gfe::library::UpdateInterface> interface, std::shared_ptr<gfe::graph::WeightedEdgeStream> stream, int64_t num_threads, uint64_t window_size);
+
+    // Destructor
+    ~SlidingWindow();
+
+    // Set how many times to replay the stream. In the following passes, the edges are inserted again after they expired.
+    void set_num_passes(uint64_t value);
+
+    // Set how frequently create a new snapshot/delta in the library (0 = do not create new snapshots)
+    void set_build_frequency(std::chrono::milliseconds millisecs);
+
+    // Set how frequently invoke the garbage collector of the library (0 = never, rely on the library)
+    void set_gc_frequency(std::chrono::milliseconds millisecs);
+
+    // Set how often to sample the throughput and the memory footprint
+    void set_report_interval(std::chrono::milliseconds millisecs);
+
+    // Set the max time to run the experiment
+    void set_timeout(std::chrono::seconds secs);
+
+    // Whether to measure the physical or the virtual memory in the memory footprint
+    void set_memfp_physical(bool value);
+
+    // Whether to print to stdout the progress of the experiment
+    void set_report_progress(bool value);
+
+    // Execute the experiment
+    std::chrono::microseconds execute();
+
+    // Store the results into the database
+    void save();
+};
+
+} // namespace
@@ -249,19 +249,51 @@ void WeightedEdgeStream::sort_by_src_dst(){
     uint64_t* __restrict permutation = ptr_permutation.get();
     for(size_t i = 0; i < m_num_edges; i++){ permutation[i] = i; }
 
-    common::sort(permutation, m_num_edges, [this](uint64_t i, uint64_t j){
-        uint64_t source_i = m_sources->get_value_at(i);
-        uint64_t source_j = m_sources->get_value_at(j);
-        if(source_i < source_j) {
-            return true;
-        } else if (source_i == source_j){
-            uint64_t dest_i = m_destinations->get_value_at(i);
-            uint64_t dest_j = m_destinations->get_value_at(j);
-            return dest_i < dest_j;
-        } else { // source_i > source_j
-            return false;
+    common::sort(permutation, m_num_edges, [this](uint64_t i, uint64_t j){ return less_src_dst(i, j); });
+
+    do_permute_edges(permutation);
+
+    timer.stop();
+
+    LOG("Sorting completed in " << timer);
+}
+
+void WeightedEdgeStream::sort_by_src_dst(uint64_t chunk_size){
+    if(m_num_edges <= 0) return; // there is nothing to sort
+    if(chunk_size == 0) INVALID_ARGUMENT("The size of a chunk cannot be zero");
+    if(chunk_size >= m_num_edges){ sort_by_src_dst(); return; }
+
+    LOG("Sorting the edge list by <source, destination> in chunks of " << chunk_size << " edges ...");
+
+    Timer timer;
+    timer.start();
+
+    // Create the permutation array
+    auto ptr_permutation = make_unique<uint64_t[]>(m_num_edges);
+    uint64_t* __restrict permutation = ptr_permutation.get();
+    for(size_t i = 0; i < m_num_edges; i++){ permutation[i] = i; }
+
+    // Sort each chunk independently
+    auto sort_chunks = [this, permutation, chunk_size](uint64_t chunk_start, uint64_t chunk_end){
+        for(uint64_t chunk = chunk_start; chunk < chunk_end; chunk++){
+            uint64_t start = chunk * chunk_size;
+            uint64_t end = std::min(start + chunk_size, m_num_edges);
+            std::sort(permutation + start, permutation + end, [this](uint64_t i, uint64_t j){ return less_src_dst(i, j); });
         }
-    });
+    };
+    const uint64_t num_chunks = (m_num_edges + chunk_size -1) / chunk_size;
+    const uint64_t num_tasks = std::min<uint64_t>(num_chunks, std::max<uint64_t>(1u, thread::hardware_concurrency()));
+    const uint64_t chunks_per_task = num_chunks / num_tasks;
+    const uint64_t odd_tasks = num_chunks % num_tasks;
+    uint64_t start = 0;
+    std::vector<future<void>> tasks;
+    tasks.reserve(num_tasks);
+    for(size_t i = 0; i < num_tasks; i++){
+        uint64_t length = chunks_per_task + (i < odd_tasks);
+        tasks.push_back( async(launch::async, sort_chunks, start, start + length) );
+        start += length; // next task
+    }
+    for(auto& t: tasks) t.get();  // wait for all tasks to finish
 
     do_permute_edges(permutation);
 
@@ -270,6 +302,20 @@ void WeightedEdgeStream::sort_by_src_dst(){
     LOG("Sorting completed in " << timer);
 }
 
+bool WeightedEdgeStream::less_src_dst(uint64_t i, uint64_t j) const {
+    uint64_t source_i = m_sources->get_value_at(i);
+    uint64_t source_j = m_sources->get_value_at(j);
+    if(source_i < source_j) {
+        return true;
+    } else if (source_i == source_j){
+        uint64_t dest_i = m_destinations->get_value_at(i);
+        uint64_t dest_j = m_destinations->get_value_at(j);
+        return dest_i < dest_j;
+    } else { // source_i > source_j
+        return false;
+    }
+}
+
 void WeightedEdgeStream::sort_by_dst_src(){
     if(m_num_edges <= 0) return; // there is nothing to sort
 
@@ -52,6 +52,9 @@ class WeightedEdgeStream {
     // Permute the edges according to the given permutation vector, with indices in 0, ..., num_edges -1
     void do_permute_edges(uint64_t* permutation);
 
+    // Compare the edges at the positions i and j by <src, dst>
+    bool less_src_dst(uint64_t i, uint64_t j) const;
+
 public:
     /**
      * Load the list of edges from the given file
@@ -97,6 +100,9 @@ public:
     void sort();
     void sort_by_src_dst();
 
+    // Sort by <src, dst> each chunk of `chunk_size' consecutive edges, without moving the edges across chunks
+    void sort_by_src_dst(uint64_t chunk_size);
+
     // Sort the edge list by <dst, src>
     void sort_by_dst_src();
 };
@@ -32,6 +32,7 @@
 #include "common/system.hpp"
 #include "common/timer.hpp"
 #include "configuration.hpp" // LOG
+#include "graph/edge_stream.hpp"
 #include "reader/reader.hpp"
 #include "third-party/robin_hood/robin_hood.h"
 
@@ -368,6 +369,75 @@ void AdjacencyList::load(const std::string& path){
     }
 }
 
+void AdjacencyList::bulk_load(const gfe::graph::WeightedEdgeStream& stream){
+    scoped_lock<mutex_t> lock(m_mutex);
+    for(uint64_t i = 0, end = stream.num_edges(); i < end; i++){
+        auto edge = stream.get(i);
+        if(edge.source() == edge.destination()) INVALID_ARGUMENT("Cannot insert an edge with the same source and destination: " << edge);
+        add_edge_v2_impl(edge);
+    }
+}
+
+
+/*****************************************************************************
+ *                                                                           *
+ *  Snapshots                                                                *
+ *                                                                           *
+ *****************************************************************************/
+static void snapshot_write_list(fstream& handle, const vector<pair<uint64_t, double>>& list){
+    uint64_t size = list.size();
+    handle.write((const char*) &size, sizeof(size));
+    handle.write((const char*) list.data(), size * sizeof(list[0]));
+}
+
+static void snapshot_read_list(fstream& handle, vector<pair<uint64_t, double>>& list){
+    uint64_t size = 0;
+    handle.read((char*) &size, sizeof(size));
+    list.resize(size);
+    handle.read((char*) list.data(), size * sizeof(list[0]));
+}
+
+bool AdjacencyList::save_snapshot(const std::string& path){
+    shared_lock<mutex_t> lock(m_mutex);
+    fstream handle(path, ios_base::out | ios_base::binary | ios_base::trunc);
+    if(!handle.good()) ERROR("Cannot open the file `" << path << "' to save the snapshot");
+
+    uint64_t num_vertices = m_adjacency_list.size();
+    handle.write((const char*) &num_vertices, sizeof(num_vertices));
+    handle.write((const char*) &m_num_edges, sizeof(m_num_edges));
+    for(const auto& vertex : m_adjacency_list){
+        handle.write((const char*) &vertex.first, sizeof(vertex.first));
+        snapshot_write_list(handle, vertex.second.first);
+        snapshot_write_list(handle, vertex.second.second);
+    }
+
+    if(!handle.good()) ERROR("Error while writing the snapshot to `" << path << "'");
+    handle.close();
+    return true;
+}
+
+bool AdjacencyList::load_snapshot(const std::string& path){
+    scoped_lock<mutex_t> lock(m_mutex);
+    fstream handle(path, ios_base::in | ios_base::binary);
+    if(!handle.good()) ERROR("Cannot open the snapshot `" << path << "'");
+
+    m_adjacency_list.clear();
+    uint64_t num_vertices = 0;
+    handle.read((char*) &num_vertices, sizeof(num_vertices));
+    handle.read((char*) &m_num_edges, sizeof(m_num_edges));
+    m_adjacency_list.reserve(num_vertices);
+    for(uint64_t i = 0; i < num_vertices; i++){
+        uint64_t vertex_id = 0;
+        handle.read((char*) &vertex_id, sizeof(vertex_id));
+        EdgePair& edges = m_adjacency_list[vertex_id];
+        snapshot_read_list(handle, edges.first);
+        snapshot_read_list(handle, edges.second);
+    }
+
+    if(!handle.good()) ERROR("The snapshot `" << path << "' is truncated or corrupted");
+    handle.close();
+    return true;
+}
 
 /*****************************************************************************
  *                                                                           *
@@ -160,6 +160,21 @@ public:
      */
     virtual void load(const std::string& path);
 
+    /**
+     * Insert all edges from the given stream, acquiring the latch of the adjacency list only once
+     */
+    virtual void bulk_load(const gfe::graph::WeightedEdgeStream& stream);
+
+    /**
+     * Save the content of the adjacency list in the given file, in binary format
+     */
+    virtual bool save_snapshot(const std::string& path);
+
+    /**
+     * Replace the content of the adjacency list with the snapshot in the given file
+     */
+    virtual bool load_snapshot(const std::string& path);
+
     /**
      * Set a timeout for a graph computation. If the computation does not terminate with the given time buget, it raises a TimeoutError
      */
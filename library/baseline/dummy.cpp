@@ -25,6 +25,12 @@ bool Dummy::add_edge(graph::WeightedEdge e) { return true; }
 bool Dummy::add_edge_v2(graph::WeightedEdge e) { return true; }
 bool Dummy::remove_edge(graph::Edge e){ return true; }
 void Dummy::set_timeout(uint64_t seconds) { }
+void Dummy::bfs(uint64_t source_vertex_id, const char* dump2file) { }
+void Dummy::pagerank(uint64_t num_iterations, double damping_factor, const char* dump2file) { }
+void Dummy::wcc(const char* dump2file) { }
+void Dummy::cdlp(uint64_t max_iterations, const char* dump2file) { }
+void Dummy::lcc(const char* dump2file) { }
+void Dummy::sssp(uint64_t source_vertex_id, const char* dump2file) { }
 
 } // namespace
 
@@ -26,7 +26,7 @@ namespace gfe::library {
  * This is a dummy instance of the interface. All operations are *nop*. It is used simply
  * to compute the driver and network overhead in running the experiments.
  */
-class Dummy : public virtual UpdateInterface {
+class Dummy : public virtual UpdateInterface, public virtual GraphalyticsInterface {
 private:
     const bool m_is_directed; // whether the underlying graph is directed
 public:
@@ -53,6 +53,14 @@ public:
     virtual bool add_edge_v2(gfe::graph::WeightedEdge e); // returns true
     virtual bool remove_edge(graph::Edge e); // returns true
     virtual void set_timeout(uint64_t seconds); // nop
+
+    // Graphalytics kernels, all nop
+    virtual void bfs(uint64_t source_vertex_id, const char* dump2file = nullptr);
+    virtual void pagerank(uint64_t num_iterations, double damping_factor = 0.85, const char* dump2file = nullptr);
+    virtual void wcc(const char* dump2file = nullptr);
+    virtual void cdlp(uint64_t max_iterations, const char* dump2file = nullptr);
+    virtual void lcc(const char* dump2file = nullptr);
+    virtual void sssp(uint64_t source_vertex_id, const char* dump2file = nullptr);
 }; // class
 
 } // namespace
@@ -17,6 +17,7 @@
 
 #include "interface.hpp"
 
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <fstream>
@@ -24,6 +25,7 @@
 #include <iostream>
 #include <memory>
 #include <mutex>
+#include <thread>
 
 #include "common/error.hpp"
 #include "common/quantity.hpp"
@@ -41,7 +43,9 @@
 #include "llama/llama_ref.hpp"
 #include "llama-dv/llama-dv.hpp"
 #endif
+#include "graph/edge_stream.hpp"
 #include "reader/reader.hpp"
+#include "utility/memory_usage.hpp"
 #if defined(HAVE_STINGER)
 #include "stinger/stinger.hpp"
 #include "stinger-dv/stinger-dv.hpp" // dense domain of vertices
@@ -571,8 +575,51 @@ bool UpdateInterface::batch(const SingleUpdate* array, size_t array_sz, bool for
     return result;
 }
 
-bool Interface::create_epoch(uint64_t x){
-    
+bool UpdateInterface::save_snapshot(const std::string& path){
+    return false; // not supported
+}
+
+bool UpdateInterface::load_snapshot(const std::string& path){
+    return false; // not supported
+}
+
+void UpdateInterface::update_batch(const graph::WeightedEdge* updates, uint64_t num_updates){
+    for(uint64_t i = 0; i < num_updates; i++){
+        if(updates[i].m_weight >= 0){ // insert
+            if( ! add_edge_v2(updates[i]) ){ // avoid infinite loops/waits
+                auto op = [this](graph::WeightedEdge edge){ return add_edge_v2(edge); };
+                batch_try_again(op, updates[i]);
+            }
+        } else { // remove
+            if( ! remove_edge(updates[i].edge()) ){ // avoid infinite loops/waits
+                auto op = [this](graph::Edge edge){ return remove_edge(edge); };
+                batch_try_again(op, updates[i].edge());
+            }
+        }
+    }
+}
+
+bool Interface::create_epoch(uint64_t epoch){
+    return false; // not supported
+}
+
+bool Interface::pin_epoch(uint64_t epoch){
+    return false; // not supported
+}
+
+void Interface::unpin_epoch(uint64_t epoch){
+    /* nop */
+}
+
+GCResult Interface::run_gc(std::chrono::microseconds budget){
+    GCResult result;
+    int64_t memfp_before = utility::MemoryUsage::memory_footprint(); // 0 if the profiler is not active
+    result.m_gc_start = chrono::steady_clock::now(); // do not time the scans of the memory footprint
+    run_gc();
+    result.m_gc_end = chrono::steady_clock::now();
+    int64_t memfp_after = utility::MemoryUsage::memory_footprint();
+    if(memfp_before > memfp_after){ result.m_reclaimed_bytes = memfp_before - memfp_after; }
+    return result;
 }
 
 template<typename Action, typename Edge>
@@ -602,6 +649,44 @@ void UpdateInterface::load(const string& path) {
     build();
 }
 
+void UpdateInterface::bulk_load(const graph::WeightedEdgeStream& stream){
+    constexpr uint64_t batch_size = 4096; // number of consecutive edges fetched & inserted at the time by a thread
+    const int num_threads = std::max<int>(1, configuration().num_threads(THREADS_WRITE));
+    const uint64_t num_edges = stream.num_edges();
+    atomic<uint64_t> next_batch = 0;
+
+    on_main_init(num_threads);
+    updates_start();
+
+    vector<thread> threads;
+    for(int i = 0; i < num_threads; i++){
+        threads.emplace_back([this, &stream, &next_batch, num_edges](int thread_id){
+            common::concurrency::set_thread_name("Bulk load #" + to_string(thread_id));
+            on_thread_init(thread_id);
+
+            vector<graph::WeightedEdge> batch;
+            batch.reserve(batch_size);
+            uint64_t start;
+            while( (start = next_batch.fetch_add(batch_size)) < num_edges ){
+                uint64_t end = std::min<uint64_t>(start + batch_size, num_edges);
+                batch.clear();
+                for(uint64_t pos = start; pos < end; pos++){ batch.push_back(stream.get(pos)); }
+                update_batch(batch.data(), batch.size());
+            }
+
+            on_thread_destroy(thread_id);
+        }, i);
+    }
+    for(auto& t : threads) t.join();
+
+    updates_stop();
+
+    on_thread_init(0);
+    build();
+    on_thread_destroy(0);
+    on_main_destroy();
+}
+
 void UpdateInterface::build(){
     /* nop */
 }
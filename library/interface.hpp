@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <ostream>
@@ -25,6 +27,8 @@
 #include "common/error.hpp"
 #include "graph/edge.hpp"
 
+namespace gfe::graph { class WeightedEdgeStream; } // forward declaration
+
 namespace gfe::library {
 
 // Forward declarations
@@ -35,6 +39,16 @@ class LoaderInterface;
 // Raised if the computation did not complete in the given time budget.
 DEFINE_EXCEPTION(TimeoutError);
 
+/**
+ * The outcome of a single invocation to Interface#run_gc(budget)
+ */
+struct GCResult {
+    uint64_t m_reclaimed_bytes = 0; // amount of memory released by the invocation, in bytes (0 = nothing reclaimed or unknown)
+    uint64_t m_remaining = 0; // estimate of the garbage left to reclaim, in units specific to the library (0 = nothing left)
+    std::chrono::steady_clock::time_point m_gc_start; // when the library started to reclaim the garbage, excluding the accounting of the invocation (unset = unknown)
+    std::chrono::steady_clock::time_point m_gc_end; // when the library finished to reclaim the garbage (unset = unknown)
+};
+
 /**
  * The manifest associated the name of a system implementation, that can be evaluated, with a factory method to create an instance
  * of the given system. A manifest is an entry in the list of all available implementations, that can be retrieved using the function
@@ -153,11 +167,45 @@ public:
 
     virtual bool has_weights() const;
 
-    virtual bool create_epoch(uint64_t);
+    /**
+     * Create a new epoch with the given id, that is a consistent snapshot of the graph that the readers can pin. The ids
+     * are increasing. By default this operation is a `nop'.
+     * @return true if the epoch has been created, false if the library does not support epochs
+     */
+    virtual bool create_epoch(uint64_t epoch);
 
+    /**
+     * Advise the library that the following reads issued by the current thread, until #unpin_epoch is invoked, should
+     * observe the snapshot of the given epoch. The pin is only advisory: the driver invokes it from the thread that
+     * starts an analytic kernel, while the kernel may run on the internal threads of the library, hence an
+     * implementation must propagate the pin to its own threads. By default this operation is a `nop' and the reads
+     * observe the latest state of the graph.
+     * @return true if the epoch has been pinned, false if the library ignores the pin
+     */
+    virtual bool pin_epoch(uint64_t epoch);
+
+    /**
+     * Release the epoch previously pinned with #pin_epoch. By default this operation is a `nop'.
+     */
+    virtual void unpin_epoch(uint64_t epoch);
+
+    /**
+     * Reclaim the memory of the versions no longer visible by any epoch. By default this operation is a `nop'.
+     */
     virtual void run_gc(){
         
     };
+
+    /**
+     * Invoke the garbage collector and report its outcome. The budget is only a hint: a library able to interrupt its
+     * garbage collector may stop once the budget is exhausted and report the garbage left, to be reclaimed by the next
+     * invocation. The default implementation performs a full #run_gc(), ignoring the budget, and estimates the memory
+     * reclaimed from the memory footprint of the process, when the memory profiler is active. The footprint is scanned
+     * outside the interval reported by GCResult#m_gc_start and #m_gc_end. With concurrent updates, the estimate is only
+     * an approximation.
+     * @param budget the maximum amount of time to spend in the invocation, 0 = no limit
+     */
+    virtual GCResult run_gc(std::chrono::microseconds budget);
 };
 
 /**
@@ -188,7 +236,7 @@ public:
 class UpdateInterface : public virtual Interface, public virtual LoaderInterface {
 private:
     /**
-     * Helper function for the implementation of bool batch(...);
+     * Helper function for the implementation of bool batch(...) and #update_batch;
      * Constantly invoke action(edge) until either it returns true or a timeout has expired. If timeout
      * expired, the function throws a TimeoutError.
      */
@@ -235,6 +283,15 @@ public:
      */
     virtual void load(const std::string& path) override; // default implementation provided in terms of #add_vertex and #add_edge
 
+    /**
+     * Populate the graph, initially empty, with all edges from the given stream, in the same order of the stream, as fast
+     * as possible. The operation is not part of the measured experiments, but it is used to prepare the graph before running
+     * the read-only benchmarks, such as the Graphalytics suite.
+     * Libraries with an efficient builder can override this method. The default implementation inserts the edges in parallel,
+     * with --writers threads, passing blocks of consecutive edges to #update_batch. All weights in the stream must be >= 0.
+     */
+    virtual void bulk_load(const gfe::graph::WeightedEdgeStream& stream);
+
     /**
      * Create a new snapshot. By default this operation is a `nop'.
      * In LLAMA, it creates a new level, moving all pending updates in the write store into a new delta in the read-only store.
@@ -246,6 +303,32 @@ public:
      */
     virtual uint64_t num_levels() const;
 
+    /**
+     * Save a snapshot of the whole graph in the given file, so that it can be restored later with #load_snapshot.
+     * Used to checkpoint the progress of long running experiments. The operation is optional, and it is invoked
+     * when no updates are in progress.
+     * @return true if the snapshot has been saved, false if the library does not support snapshots
+     */
+    virtual bool save_snapshot(const std::string& path);
+
+    /**
+     * Replace the content of the graph with the snapshot stored in the given file, by a previous call to #save_snapshot
+     * @return true if the snapshot has been loaded, false if the library does not support snapshots
+     */
+    virtual bool load_snapshot(const std::string& path);
+
+    /**
+     * Apply a sequence of edge updates in the given order. An update with a weight >= 0 is an edge insertion and
+     * implicitly creates the referred vertices, as in #add_edge_v2. An update with a negative weight is an edge deletion.
+     * Unlike #batch, this method is meant to be overridden by the libraries that can group many updates into a single
+     * transaction. On return, all updates must have been performed.
+     * The default implementation performs the updates one by one, with #add_edge_v2 and #remove_edge, and throws a
+     * TimeoutError when an update still fails after retrying it for 10 minutes.
+     * @param updates the list of edge updates
+     * @param num_updates the size of the list of edge updates
+     */
+    virtual void update_batch(const gfe::graph::WeightedEdge* updates, uint64_t num_updates);
+
     /**
      * Perform a batch of edge insertions/deletions.
      * -- LIBRARY IMPLEMENTATIONS SHALL NOT OVERRIDE THIS METHOD: this is only used by the driver in client-server
@@ -19,6 +19,7 @@
 
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cmath>
 #include <fstream>
 #include <iostream>
@@ -331,6 +332,80 @@ bool LiveGraphDriver::remove_edge(gfe::graph::Edge e){
     }
 }
 
+void LiveGraphDriver::update_batch(const gfe::graph::WeightedEdge* updates, uint64_t num_updates){
+    thread_local vector<pair<lg::vertex_t, lg::vertex_t>> internal_ids; // map the vertices of the batch into the internal ids
+    internal_ids.clear();
+    constexpr lg::vertex_t NOT_FOUND = numeric_limits<lg::vertex_t>::max();
+
+    for(uint64_t i = 0; i < num_updates; i++){
+        const gfe::graph::WeightedEdge& e = updates[i];
+        if(e.m_weight >= 0){ add_vertex(e.source()); add_vertex(e.destination()); } // nop if they already exist
+
+        vertex_dictionary_t::const_accessor slock1, slock2;
+        lg::vertex_t internal_source_id = VertexDictionary->find(slock1, e.source()) ? slock1->second : NOT_FOUND;
+        lg::vertex_t internal_destination_id = VertexDictionary->find(slock2, e.destination()) ? slock2->second : NOT_FOUND;
+        internal_ids.emplace_back(internal_source_id, internal_destination_id);
+    }
+
+    uint64_t start = 0;
+    uint64_t max_tx_size = num_updates; // max number of updates in a single transaction, shrunk on conflicts
+    chrono::microseconds backoff { 0 }; // how long to wait before retrying a transaction that has been rolled back
+    while(start < num_updates){
+        uint64_t end = start; // the first update not performed by the transaction
+        int64_t num_edges_delta = 0;
+        bool done = false;
+        do {
+            try {
+                end = start;
+                num_edges_delta = 0;
+                auto tx = LiveGraph->begin_transaction();
+
+                bool edge_not_found = false; // a deletion refers to an edge that does not exist (yet)
+                while(end < num_updates && end - start < max_tx_size && !edge_not_found){
+                    lg::vertex_t internal_source_id = internal_ids[end].first;
+                    lg::vertex_t internal_destination_id = internal_ids[end].second;
+
+                    if(updates[end].m_weight >= 0){ // insertion
+                        string_view weight { (char*) &updates[end].m_weight, sizeof(updates[end].m_weight) };
+                        tx.put_edge(internal_source_id, /* label */ 0, internal_destination_id, weight);
+                        lg::label_t label = m_is_directed ? 1 : 0; // same convention of #add_edge_v2
+                        tx.put_edge(internal_destination_id, /* label */ label, internal_source_id, weight);
+                        num_edges_delta++;
+                        end++;
+                    } else if (internal_source_id != NOT_FOUND && internal_destination_id != NOT_FOUND && tx.del_edge(internal_source_id, /* label */ 0, internal_destination_id)) { // deletion
+                        if(!m_is_directed){ // undirected graph
+                            tx.del_edge(internal_destination_id, /* label */ 0, internal_source_id);
+                        }
+                        num_edges_delta--;
+                        end++;
+                    } else {
+                        edge_not_found = true;
+                    }
+                }
+
+                tx.commit();
+                done = true;
+            } catch (lg::Transaction::RollbackExcept& e){
+                // retry only the updates before the conflict, or the conflicting update alone, after waiting a bit
+                max_tx_size = max<uint64_t>(1, min(end - start, max_tx_size / 2));
+                backoff = min<chrono::microseconds>(max<chrono::microseconds>(2 * backoff, 1us), 1ms);
+                this_thread::sleep_for(backoff);
+            }
+        } while(!done);
+        max_tx_size = num_updates; // the transaction went through, restore its size for the next updates
+        backoff = 0us;
+        m_num_edges += num_edges_delta;
+
+        // do not drop the deletion, perform it as #remove_edge would do, until either it succeeds or a timeout expires
+        if(end < num_updates){
+            UpdateInterface::update_batch(updates + end, 1);
+            end++;
+        }
+
+        start = end;
+    }
+}
+
 double LiveGraphDriver::get_weight(uint64_t source, uint64_t destination) const {
     // check whether the referred vertices exist
     vertex_dictionary_t::const_accessor slock1, slock2;
@@ -129,6 +129,15 @@ public:
      */
     virtual bool remove_edge(gfe::graph::Edge e);
 
+    /**
+     * Apply the given sequence of updates in a single transaction. The missing vertices are created beforehand,
+     * each in its own transaction. A deletion of an edge that does not exist (yet) ends the transaction and is
+     * retried on its own as in the default implementation, which throws a TimeoutError if it never succeeds.
+     * When a transaction is rolled back due to a conflict, it is retried after a short backoff with only the updates
+     * that preceded the conflict, down to the conflicting update alone.
+     */
+    virtual void update_batch(const gfe::graph::WeightedEdge* updates, uint64_t num_updates);
+
     /**
      * Dump the content of the graph to given stream.
      */
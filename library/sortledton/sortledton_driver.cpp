@@ -8,6 +8,7 @@
 #include <optional>
 #include <omp.h>
 #include <iostream>
+#include <unordered_set>
 
 //#include "third-party/gapbs/gapbs.hpp"
 
@@ -52,12 +53,26 @@ namespace gfe::library {
       tm.reset_max_threads(num_threads);
     }
 
+    // The thread_id registered by the current thread with #on_thread_init, -1 if the thread has not been registered
+    static thread_local int g_thread_id = -1;
+
     void SortledtonDriver::on_thread_init(int thread_id) {
       tm.register_thread(thread_id);
+      g_thread_id = thread_id;
     }
 
     void SortledtonDriver::on_thread_destroy(int thread_id) {
       tm.deregister_thread(thread_id);
+      g_thread_id = -1;
+    }
+
+    void SortledtonDriver::kernel_thread_init() {
+      // the threads of the analytic clients in the mixed workload are already registered, each with its own thread_id
+      if (g_thread_id < 0) { tm.register_thread(0); }
+    }
+
+    void SortledtonDriver::kernel_thread_destroy() {
+      if (g_thread_id < 0) { tm.deregister_thread(0); }
     }
 
     void SortledtonDriver::dump_ostream(std::ostream &out) const {
@@ -278,13 +293,65 @@ namespace gfe::library {
       return removed;
     }
 
+    void SortledtonDriver::update_batch(const gfe::graph::WeightedEdge* updates, uint64_t num_updates) {
+      assert(!m_is_directed);
+
+      thread_local optional <SnapshotTransaction> tx_o = nullopt;
+      thread_local unordered_set <uint64_t> vertices; // vertices already inserted in the current transaction
+      thread_local unordered_set <uint64_t> edges; // hashes of the edges already touched by the current transaction
+
+      uint64_t start = 0;
+      while (start < num_updates) {
+        if (tx_o.has_value()) {
+          tm.getSnapshotTransaction(ds, true, *tx_o);
+        } else {
+          tx_o = tm.getSnapshotTransaction(ds, true);
+        }
+        auto tx = *tx_o;
+        tx.use_vertex_does_not_exists_semantics();
+        vertices.clear();
+        edges.clear();
+
+        uint64_t end = start;
+        while (end < num_updates) {
+          const gfe::graph::WeightedEdge &e = updates[end];
+          edge_t internal_edge{static_cast<dst_t>(min(e.source(), e.destination())),
+                               static_cast<dst_t>(max(e.source(), e.destination()))};
+          // the same edge twice, close the transaction. A hash collision only causes an earlier commit
+          uint64_t edge_key = static_cast<uint64_t>(internal_edge.src) * 0x9E3779B97F4A7C15ull ^ static_cast<uint64_t>(internal_edge.dst);
+          if (!edges.insert(edge_key).second) { break; }
+
+          if (e.m_weight >= 0) { // insertion
+            if (vertices.insert(internal_edge.src).second) { tx.insert_vertex(internal_edge.src); }
+            if (vertices.insert(internal_edge.dst).second) { tx.insert_vertex(internal_edge.dst); }
+            tx.insert_edge({internal_edge.dst, internal_edge.src}, (char *) &e.m_weight, sizeof(e.m_weight));
+            tx.insert_edge(internal_edge, (char *) &e.m_weight, sizeof(e.m_weight));
+          } else { // deletion
+            tx.delete_edge({internal_edge.dst, internal_edge.src});
+            tx.delete_edge(internal_edge);
+          }
+
+          end++;
+        }
+
+        bool done = tx.execute();
+        tm.transactionCompleted(tx);
+
+        if (!done) { // fall back to the single updates
+          UpdateInterface::update_batch(updates + start, end - start);
+        }
+
+        start = end;
+      }
+    }
+
     void SortledtonDriver::run_gc() {
       if (!gced) {
         Timer t;
         t.start();
         ds->gc_all();
         // gced = true;
-        cout << "Running GC took: " << t;
+        COUT_DEBUG("Running GC took: " << t);
       }
     }
 
@@ -331,7 +398,7 @@ namespace gfe::library {
 
 
     void SortledtonDriver::bfs(uint64_t source_vertex_id, const char *dump2file) {
-      tm.register_thread(0);
+      kernel_thread_init();
       SnapshotTransaction tx = tm.getSnapshotTransaction(ds, false, false);
 
       // run_gc();
@@ -354,12 +421,12 @@ namespace gfe::library {
       if (dump2file != nullptr) {
         save_bfs(external_ids, dump2file);
       }
-      tm.deregister_thread(0);
+      kernel_thread_destroy();
     }
 
 
     void SortledtonDriver::pagerank(uint64_t num_iterations, double damping_factor, const char *dump2file) {
-      tm.register_thread(0);
+      kernel_thread_init();
       SnapshotTransaction tx = tm.getSnapshotTransaction(ds, false, false);
 
       // run_gc();
@@ -372,11 +439,11 @@ namespace gfe::library {
       if (dump2file != nullptr) {
         save_result<double>(external_ids, dump2file);
       }
-      tm.deregister_thread(0);
+      kernel_thread_destroy();
     }
 
     void SortledtonDriver::wcc(const char *dump2file) {
-      tm.register_thread(0);
+      kernel_thread_init();
       SnapshotTransaction tx = tm.getSnapshotTransaction(ds, false, false);
 
       // run_gc();
@@ -390,11 +457,11 @@ namespace gfe::library {
       if (dump2file != nullptr) {
         save_result<uint64_t>(external_ids, dump2file);
       }
-      tm.deregister_thread(0);
+      kernel_thread_destroy();
     }
 
     void SortledtonDriver::cdlp(uint64_t max_iterations, const char *dump2file) {
-      tm.register_thread(0);
+      kernel_thread_init();
       SnapshotTransaction tx = tm.getSnapshotTransaction(ds, false, false);
 
       // run_gc();
@@ -407,11 +474,11 @@ namespace gfe::library {
       if (dump2file != nullptr) {
         save_result<uint64_t>(external_ids, dump2file);
       }
-      tm.deregister_thread(0);
+      kernel_thread_destroy();
     }
 
     void SortledtonDriver::sssp(uint64_t source_vertex_id, const char *dump2file) {
-      tm.register_thread(0);
+      kernel_thread_init();
       SnapshotTransaction tx = tm.getSnapshotTransaction(ds, false, false);
 
       // run_gc();
@@ -428,7 +495,7 @@ namespace gfe::library {
       if (dump2file != nullptr) {
         save_result<double>(external_ids, dump2file);
       }
-      tm.deregister_thread(0);
+      kernel_thread_destroy();
     }
 
     bool SortledtonDriver::can_be_validated() const {
@@ -657,7 +724,7 @@ namespace gfe::library {
     }
 
     void SortledtonDriver::lcc(const char *dump2file) {
-      tm.register_thread(0);
+      kernel_thread_init();
       SnapshotTransaction tx = tm.getSnapshotTransaction(ds, false, false);
 
       // run_gc();
@@ -673,7 +740,7 @@ namespace gfe::library {
       if (dump2file != nullptr) {
         save_result<double>(external_ids, dump2file);
       }
-      tm.deregister_thread(0);
+      kernel_thread_destroy();
     }
 
     bool SortledtonDriver::create_epoch(uint64_t version){
@@ -39,6 +39,12 @@ namespace gfe::library {
         std::chrono::seconds m_timeout{0}; // the budget to complete each of the algorithms in the Graphalytics suite
         bool gced = false;
 
+        // Register the thread executing a Graphalytics kernel, unless already registered with #on_thread_init
+        void kernel_thread_init();
+
+        // Deregister the thread executing a Graphalytics kernel, if registered by #kernel_thread_init
+        void kernel_thread_destroy();
+
         template <typename T>
         vector<pair<uint64_t, T>> translate(SnapshotTransaction& tx, vector<T>& values) {
           int N = values.size();
@@ -152,6 +158,13 @@ namespace gfe::library {
          */
         virtual bool remove_edge(gfe::graph::Edge e);
 
+        /**
+         * Apply the given sequence of updates, grouping them in as few transactions as possible. A transaction is
+         * closed as soon as the same edge appears twice, to retain the order of the updates. If a transaction
+         * fails, its updates are performed one by one.
+         */
+        virtual void update_batch(const gfe::graph::WeightedEdge* updates, uint64_t num_updates);
+
         virtual void on_main_init(int num_threads);
 
         /**
@@ -212,7 +225,8 @@ namespace gfe::library {
         virtual bool create_epoch(uint64_t);
 
 
-        virtual void run_gc();
+        virtual void run_gc() override;
+        using Interface::run_gc; // run_gc(budget), with the default implementation
 
 
     };
@@ -270,13 +270,10 @@ namespace gfe::library {
     }
 
     void SortledtonDriverV2::run_gc() {
-      if (!gced) {
-        Timer t;
-        t.start();
-        ds.gc_all();
-        gced = true;
-        cout << "Running GC took: " << t;
-      }
+      Timer t;
+      t.start();
+      ds.gc_all();
+      COUT_DEBUG("Running GC took: " << t);
     }
 
     static void save_bfs(vector <pair<uint64_t, uint>> &result, const char *dump2file) {
@@ -322,8 +319,6 @@ namespace gfe::library {
 
 
     void SortledtonDriverV2::bfs(uint64_t source_vertex_id, const char *dump2file) {
-      run_gc();
-
       auto physical_src = tx.physical_id(source_vertex_id);
       auto distances = sortledton::algorithms::BFS::bfs(tx, physical_src);
       auto external_ids = translate_bfs(tx, distances);
@@ -335,8 +330,6 @@ namespace gfe::library {
 
 
     void SortledtonDriverV2::pagerank(uint64_t num_iterations, double damping_factor, const char *dump2file) {
-      run_gc();
-
       auto pr = sortledton::algorithms::PageRank::page_rank_bs(tx, num_iterations, damping_factor);
       auto external_ids = translate<double>(tx, pr);
 
@@ -346,8 +339,6 @@ namespace gfe::library {
     }
 
     void SortledtonDriverV2::wcc(const char *dump2file) {
-      run_gc();
-
       auto clusters = sortledton::algorithms::WCC::gapbs_wcc(tx);
       auto external_ids = translate<uint64_t>(tx, clusters);
 
@@ -357,8 +348,6 @@ namespace gfe::library {
     }
 
     void SortledtonDriverV2::cdlp(uint64_t max_iterations, const char *dump2file) {
-      run_gc();
-
       auto clusters = sortledton::algorithms::CDLP::teseo_cdlp(tx, max_iterations);
       auto external_ids = translate<uint64_t>(tx, clusters);
 
@@ -368,8 +357,6 @@ namespace gfe::library {
     }
 
     void SortledtonDriverV2::sssp(uint64_t source_vertex_id, const char *dump2file) {
-      run_gc();
-
       auto physical_src = tx.physical_id(source_vertex_id);
       auto distances = sortledton::algorithms::SSSP::gabbs_sssp(tx, physical_src, 2.0);
       auto external_ids = translate<double>(tx, distances);
@@ -603,8 +590,6 @@ namespace gfe::library {
     }
 
     void SortledtonDriverV2::lcc(const char *dump2file) {
-      run_gc();
-
       auto lcc_values = GFELCC::execute(tx);
       auto external_ids = translate<double>(tx, lcc_values);
 
@@ -31,7 +31,6 @@ using namespace std;
       sortledton::storage::VersionedGraphStore ds;
       sortledton::storage::GraphStorageForwarder tx;
         std::chrono::seconds m_timeout{0}; // the budget to complete each of the algorithms in the Graphalytics suite
-        bool gced = false;
 
         template <typename T>
         vector<pair<uint64_t, T>> translate(sortledton::storage::GraphStorageForwarder& tx, vector<T>& values) {
@@ -66,9 +65,6 @@ using namespace std;
           handle.close();
         }
 
-        void run_gc();
-
-
     public:
 
         SortledtonDriverV2(bool is_graph_directed, int block_size);
@@ -208,6 +204,14 @@ using namespace std;
         virtual void sssp(uint64_t source_vertex_id, const char *dump2file = nullptr);
 
         virtual bool can_be_validated() const;
+
+        /**
+         * Reclaim the versions no longer visible, with a full pass over the graph. It is no longer invoked implicitly by the
+         * Graphalytics kernels, the driver invokes it in background or before running the kernels. Each invocation
+         * reclaims the versions expired since the previous one.
+         */
+        virtual void run_gc() override;
+        using Interface::run_gc; // run_gc(budget), with the default implementation
     };
 
 }
@@ -173,11 +173,12 @@ bool TeseoDriver::add_edge(gfe::graph::WeightedEdge e) {
     }
 }
 
-bool TeseoDriver::add_edge_v2(gfe::graph::WeightedEdge e){
-    static cuckoohash_map<uint64_t, bool> vertices;
+// vertices already created by #add_edge_v2 and #update_batch
+static cuckoohash_map<uint64_t, bool> g_vertices;
 
-    if(vertices.insert(e.source(), true)){ add_vertex(e.source()); }
-    if(vertices.insert(e.destination(), true)){ add_vertex(e.destination()); }
+bool TeseoDriver::add_edge_v2(gfe::graph::WeightedEdge e){
+    if(g_vertices.insert(e.source(), true)){ add_vertex(e.source()); }
+    if(g_vertices.insert(e.destination(), true)){ add_vertex(e.destination()); }
     while( ! add_edge(e) ) { /* nop */ }
 
     return true;
@@ -196,6 +197,41 @@ bool TeseoDriver::remove_edge(gfe::graph::Edge e) {
     }
 }
 
+void TeseoDriver::update_batch(const gfe::graph::WeightedEdge* updates, uint64_t num_updates){
+    // the vertices are created in their own transactions, as in #add_edge_v2, so that a rollback
+    // of the batch does not lose them
+    for(uint64_t i = 0; i < num_updates; i++){
+        if(updates[i].m_weight >= 0){
+            if(g_vertices.insert(updates[i].source(), true)){ add_vertex(updates[i].source()); }
+            if(g_vertices.insert(updates[i].destination(), true)){ add_vertex(updates[i].destination()); }
+        }
+    }
+
+    bool done = false;
+    { // the transaction is rolled back by its destructor, if it has not been committed
+        auto tx = TESEO->start_transaction();
+        try {
+            for(uint64_t i = 0; i < num_updates; i++){
+                if(updates[i].m_weight >= 0){ // insertion
+                    tx.insert_edge(updates[i].source(), updates[i].destination(), updates[i].weight());
+                } else { // deletion
+                    tx.remove_edge(updates[i].source(), updates[i].destination());
+                }
+            }
+            tx.commit();
+            done = true;
+        } catch( LogicalError& e ){
+            done = false;
+        } catch( TransactionConflict& e) {
+            done = false;
+        }
+    }
+
+    if(!done){ // perform the updates one by one
+        UpdateInterface::update_batch(updates, num_updates);
+    }
+}
+
 /*****************************************************************************
  *                                                                           *
  *  Dump                                                                     *
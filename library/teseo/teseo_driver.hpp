@@ -136,6 +136,12 @@ public:
      */
     virtual bool remove_edge(gfe::graph::Edge e);
 
+    /**
+     * Apply the given sequence of updates in a single transaction. If the transaction fails, either due to a
+     * conflict or to a logical error, the updates are performed one by one.
+     */
+    virtual void update_batch(const gfe::graph::WeightedEdge* updates, uint64_t num_updates);
+
     /**
      * Callback, invoked when a thread is created
      */
@@ -24,9 +24,12 @@
 #include "common/system.hpp"
 #include "common/timer.hpp"
 #include "experiment/aging2_experiment.hpp"
+#include "experiment/calibration.hpp"
+#include "experiment/details/epoch_service.hpp"
 #include "experiment/mixed_workload.hpp"
 #include "experiment/mixed_workload_result.hpp"
 #include "experiment/insert_only.hpp"
+#include "experiment/sliding_window.hpp"
 #include "experiment/graphalytics.hpp"
 #include "experiment/validate.hpp"
 #include "graph/edge_stream.hpp"
@@ -49,6 +52,15 @@ using namespace gfe::experiment;
 using namespace std;
 
 
+// Generate the sequence of updates for the Aging2 experiment in the driver, as requested by the option --aging_synthetic
+static shared_ptr<details::SyntheticLog> make_synthetic_log(){
+    auto synthetic_log = make_shared<details::SyntheticLog>(configuration().get_path_graph(), details::parse_synthetic_pattern(configuration().get_aging_synthetic()), configuration().coefficient_aging(), configuration().seed());
+    synthetic_log->set_zipf_alpha(configuration().get_aging_synthetic_zipf());
+    synthetic_log->set_window(configuration().get_aging_synthetic_window());
+    synthetic_log->set_burst_period(configuration().get_aging_synthetic_burst());
+    return synthetic_log;
+}
+
 static void run_standalone(int argc, char* argv[]){
     configuration().initialise(argc, argv);
     if(configuration().get_aging_memfp() && !configuration().get_aging_memfp_physical()){
@@ -72,6 +84,15 @@ static void run_standalone(int argc, char* argv[]){
     }
 #endif
 
+    // measure the overhead of the driver, rather than evaluating a library
+    if(configuration().is_calibration()){
+        LOG("[driver] Calibration, max number of threads: " << configuration().num_threads(THREADS_WRITE));
+        Calibration calibration { path_graph, configuration().is_graph_directed(), static_cast<uint64_t>(configuration().num_threads(THREADS_WRITE)) };
+        calibration.execute();
+        if(configuration().has_database()) calibration.save();
+        return;
+    }
+
     // implementation to evaluate
     LOG("[driver] Library name: " << configuration().get_library_name() );
     shared_ptr<library::Interface> impl { configuration().generate_graph_library() };
@@ -109,8 +130,29 @@ static void run_standalone(int argc, char* argv[]){
         auto impl_upd = dynamic_pointer_cast<library::UpdateInterface>(impl);
         if(impl_upd.get() == nullptr){ ERROR("The library `" << configuration().get_library_name() << "' does not support updates"); }
 
-        if(configuration().get_update_log().empty()){
-            impl_upd->create_epoch(50);
+        if(configuration().get_sliding_window_size() > 0){
+            LOG("[driver] Sliding window, using the graph " << path_graph);
+            auto stream = make_shared<graph::WeightedEdgeStream> ( configuration().get_path_graph() );
+            if (!configuration().is_timestamped_graph()) {
+              LOG("[driver] graph is not sorted by timestamp: streaming the edges in the order of the file");
+            }
+            if(stream->num_edges() > 0) random_vertex = stream->get(0).m_source;
+            if(configuration().measure_latency()) ERROR("[driver] Sliding window, latency measurements not supported");
+
+            LOG("[driver] Number of concurrent threads: " << configuration().num_threads(THREADS_WRITE) );
+            details::EpochService::create_epoch(impl_upd.get());
+
+            SlidingWindow experiment { impl_upd, stream, configuration().num_threads(THREADS_WRITE), configuration().get_sliding_window_size() };
+            experiment.set_num_passes(configuration().get_sliding_window_passes());
+            experiment.set_build_frequency(chrono::milliseconds{ configuration().get_build_frequency() });
+            experiment.set_gc_frequency(chrono::milliseconds{ configuration().get_sliding_window_gc() });
+            experiment.set_timeout(chrono::seconds{ configuration().get_timeout_aging2() });
+            experiment.set_memfp_physical(configuration().get_aging_memfp_physical());
+            experiment.set_report_progress(true);
+            experiment.execute();
+            if(configuration().has_database()) experiment.save();
+        } else if(configuration().get_update_log().empty() && configuration().get_aging_synthetic().empty()){
+            details::EpochService::create_epoch(impl_upd.get());
             // int numVertices = 2048;
             // impl_upd->add_vertex(100);
             // for(int i=0;i<numVertices;i++){
@@ -190,13 +232,32 @@ static void run_standalone(int argc, char* argv[]){
 
             LOG("[driver] Number of concurrent threads: " << configuration().num_threads(THREADS_WRITE) );
 
-            if(configuration().measure_latency()) ERROR("[driver] InsertOnly, support for latency measurements removed");
-
-            InsertOnly experiment { impl_upd, stream, configuration().num_threads(THREADS_WRITE) };
-            experiment.set_build_frequency(chrono::milliseconds{ configuration().get_build_frequency() });
-            experiment.set_scheduler_granularity(1ull < 20);
-            experiment.execute();
-            if(configuration().has_database()) experiment.save();
+            if(configuration().is_bulk_load()){
+                stream->sort_by_src_dst(); // all builders benefit from the locality of the sources
+                LOG("[driver] Bulk loading the graph ...");
+                common::Timer timer; timer.start();
+                impl_upd->bulk_load(*stream);
+                timer.stop();
+                LOG("[driver] Bulk load performed in " << timer << ", num edges stored in the graph: " << impl_upd->num_edges());
+                if(configuration().has_database()){
+                    auto db = configuration().db()->add("bulk_load");
+                    db.add("load_time", timer.microseconds()); // microsecs
+                    db.add("num_edges", stream->num_edges());
+                }
+            } else {
+                InsertOnly experiment { impl_upd, stream, configuration().num_threads(THREADS_WRITE) };
+                experiment.set_build_frequency(chrono::milliseconds{ configuration().get_build_frequency() });
+                experiment.set_scheduler_granularity(configuration().get_insertion_granularity());
+                experiment.set_scheduler(parse_insertion_scheduler(configuration().get_insertion_scheduler()));
+                experiment.set_worker_placement(details::parse_thread_placement(configuration().get_insertion_placement()));
+                experiment.set_insertion_order(parse_insertion_order(configuration().get_insertion_order()));
+                experiment.set_measure_latency(configuration().measure_latency());
+                experiment.set_latency_sampling(configuration().get_latency_sampling());
+                experiment.set_timeline_resolution(chrono::milliseconds{ configuration().get_insertion_timeline_resolution() });
+                experiment.set_memfp_physical(configuration().get_aging_memfp_physical());
+                experiment.execute();
+                if(configuration().has_database()) experiment.save();
+            }
 
           if(configuration().validate_inserts() && impl_upd->can_be_validated()){
               num_validation_errors = validate_updates(impl_upd, stream);
@@ -213,14 +274,22 @@ static void run_standalone(int argc, char* argv[]){
             if (configuration().is_mixed_workload()) {
               LOG("[driver] Number of write threads: " << configuration().num_threads(THREADS_WRITE));
               LOG("[driver] Number of read threads: " << configuration().num_threads(THREADS_READ));
-              LOG("[driver] Aging2, path to the log of updates: " << configuration().get_update_log());
+              if(configuration().get_aging_synthetic().empty()){
+                LOG("[driver] Aging2, path to the log of updates: " << configuration().get_update_log());
+              } else {
+                LOG("[driver] Aging2, synthetic updates with the pattern: " << configuration().get_aging_synthetic());
+              }
 
-                impl_upd->create_epoch(100);
+                details::EpochService::create_epoch(impl_upd.get());
 
               // Configure aging experiment
               Aging2Experiment agingExperiment;
               agingExperiment.set_library(impl_upd);
-              agingExperiment.set_log(configuration().get_update_log());
+              if(configuration().get_aging_synthetic().empty()){
+                agingExperiment.set_log(configuration().get_update_log());
+              } else {
+                agingExperiment.set_synthetic_log(make_synthetic_log());
+              }
               agingExperiment.set_parallelism_degree(configuration().num_threads(THREADS_WRITE));
               agingExperiment.set_release_memory(configuration().get_aging_release_memory());
               agingExperiment.set_report_progress(true);
@@ -234,6 +303,15 @@ static void run_standalone(int argc, char* argv[]){
               agingExperiment.set_memfp_physical(configuration().get_aging_memfp_physical());
               agingExperiment.set_memfp_threshold(configuration().get_aging_memfp_threshold());
               agingExperiment.set_cooloff(chrono::seconds{configuration().get_aging_cooloff_seconds()});
+              agingExperiment.set_timeline_resolution(chrono::milliseconds{configuration().get_aging_timeline_resolution()});
+              agingExperiment.set_worker_placement(details::parse_thread_placement(configuration().get_aging_worker_placement()));
+              agingExperiment.set_update_batch_size(configuration().get_aging_update_batch_size());
+              agingExperiment.set_worker_granularity_target(chrono::microseconds{configuration().get_aging_granularity_target()});
+              agingExperiment.set_streaming(configuration().get_aging_streaming());
+              agingExperiment.set_read_ratio(configuration().get_aging_read_ratio());
+              agingExperiment.set_read_target(configuration().get_aging_read_target() == "random" ? ReadTarget::RANDOM : ReadTarget::RECENT);
+              agingExperiment.set_arrival_rate(configuration().get_aging_arrival_rate());
+              agingExperiment.set_arrival_process(configuration().get_aging_arrival_process() == "poisson" ? ArrivalProcess::POISSON : ArrivalProcess::CONSTANT);
               
               // Configure analytics experiment
               GraphalyticsAlgorithms properties { path_graph };
@@ -247,6 +325,23 @@ static void run_standalone(int argc, char* argv[]){
               GraphalyticsSequential exp_seq { impl_ga, configuration().num_repetitions(), properties };
 
               MixedWorkload experiment(agingExperiment, exp_seq, configuration().num_threads(ThreadsType::THREADS_READ));
+              vector<unique_ptr<GraphalyticsSequential>> other_clients;
+              for(uint64_t i = 1; i < configuration().get_analytic_clients(); i++){
+                other_clients.emplace_back(new GraphalyticsSequential{ impl_ga, configuration().num_repetitions(), properties });
+                experiment.add_client(*other_clients.back());
+              }
+              LOG("[driver] Mixed workload, number of analytic clients: " << configuration().get_analytic_clients());
+              experiment.set_epoch_frequency(chrono::milliseconds{configuration().get_epoch_frequency()});
+              experiment.set_gc_frequency(chrono::milliseconds{configuration().get_gc_frequency()});
+              experiment.set_gc_policy(details::parse_gc_policy(configuration().get_gc_policy()));
+              experiment.set_gc_budget(chrono::microseconds{configuration().get_gc_budget()});
+              MixedWorkloadSchedule schedule;
+              schedule.m_warmup_operations = configuration().get_mixed_warmup_operations();
+              schedule.m_warmup_progress = configuration().get_mixed_warmup_progress();
+              schedule.m_duration = chrono::milliseconds{configuration().get_mixed_duration()};
+              schedule.m_iterations = configuration().get_mixed_iterations();
+              schedule.m_stop_progress = configuration().get_mixed_stop_progress();
+              experiment.set_schedule(schedule);
               auto result = experiment.execute();
               cout << "Saving result" << endl;
               if (configuration().has_database()) result.save(configuration().db());
@@ -254,11 +349,19 @@ static void run_standalone(int argc, char* argv[]){
               cout << "Done saving" << endl;
             } else {
               LOG("[driver] Number of concurrent threads: " << configuration().num_threads(THREADS_WRITE));
-              LOG("[driver] Aging2, path to the log of updates: " << configuration().get_update_log());
+              if(configuration().get_aging_synthetic().empty()){
+                LOG("[driver] Aging2, path to the log of updates: " << configuration().get_update_log());
+              } else {
+                LOG("[driver] Aging2, synthetic updates with the pattern: " << configuration().get_aging_synthetic());
+              }
               Aging2Experiment experiment;
-              impl_upd->create_epoch(100);
+              details::EpochService::create_epoch(impl_upd.get());
               experiment.set_library(impl_upd);
-              experiment.set_log(configuration().get_update_log());
+              if(configuration().get_aging_synthetic().empty()){
+                experiment.set_log(configuration().get_update_log());
+              } else {
+                experiment.set_synthetic_log(make_synthetic_log());
+              }
               experiment.set_parallelism_degree(configuration().num_threads(THREADS_WRITE));
               experiment.set_release_memory(configuration().get_aging_release_memory());
               experiment.set_report_progress(true);
@@ -272,9 +375,20 @@ static void run_standalone(int argc, char* argv[]){
               experiment.set_memfp_physical(configuration().get_aging_memfp_physical());
               experiment.set_memfp_threshold(configuration().get_aging_memfp_threshold());
               experiment.set_cooloff(chrono::seconds{configuration().get_aging_cooloff_seconds()});
+              experiment.set_timeline_resolution(chrono::milliseconds{configuration().get_aging_timeline_resolution()});
+              experiment.set_worker_placement(details::parse_thread_placement(configuration().get_aging_worker_placement()));
+              experiment.set_update_batch_size(configuration().get_aging_update_batch_size());
+              experiment.set_worker_granularity_target(chrono::microseconds{configuration().get_aging_granularity_target()});
+              experiment.set_streaming(configuration().get_aging_streaming());
+              experiment.set_read_ratio(configuration().get_aging_read_ratio());
+              experiment.set_read_target(configuration().get_aging_read_target() == "random" ? ReadTarget::RANDOM : ReadTarget::RECENT);
+              experiment.set_checkpoint(configuration().get_aging_checkpoint_path(), chrono::seconds{configuration().get_aging_checkpoint_interval()});
+              experiment.set_resume(configuration().get_aging_resume());
+              experiment.set_arrival_rate(configuration().get_aging_arrival_rate());
+              experiment.set_arrival_process(configuration().get_aging_arrival_process() == "poisson" ? ArrivalProcess::POISSON : ArrivalProcess::CONSTANT);
 
               auto result = experiment.execute();
-            //   if (configuration().has_database()) result.save(configuration().db());
+              if (configuration().has_database()) result.save(configuration().db());
               random_vertex = result.get_random_vertex_id();
 
               if (configuration().validate_inserts() && impl_upd->can_be_validated()) {
@@ -322,6 +436,18 @@ static void run_standalone(int argc, char* argv[]){
             }
         }
 
+        // reclaim the garbage left by the updates, rather than inside the first kernel
+        if(configuration().is_gc_graphalytics()){
+            common::Timer timer; timer.start();
+            impl->run_gc();
+            timer.stop();
+            LOG("[driver] Garbage collection performed in " << timer);
+            if(configuration().has_database()){
+                auto db = configuration().db()->add("gc_graphalytics");
+                db.add("duration", timer.microseconds()); // microsecs
+            }
+        }
+
         exp_seq.execute();
         exp_seq.report(configuration().has_database());
     }
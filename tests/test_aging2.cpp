@@ -17,10 +17,15 @@
 
 #include "gtest/gtest.h"
 
-#include <cstdlib> // getenv
+#include <chrono>
+#include <cstdio> // remove
+#include <cstdlib> // getenv, mkstemp
 #include <memory>
+#include <thread>
+#include <unistd.h> // close
 #include <unordered_set>
 
+#include "common/error.hpp"
 #include "common/filesystem.hpp"
 #include "experiment/aging2_experiment.hpp"
 #include "graph/edge_stream.hpp"
@@ -31,9 +36,10 @@ using namespace gfe::graph;
 using namespace gfe::library;
 using namespace std;
 
+static void validate_final_graph(AdjacencyList* adjlist, const string& path_graph);
+
 static
 void validate_aging2(bool is_directed, const string& path_graph, const string& path_log, uint64_t exp_granularity = 1024){
-    auto stream = make_shared<WeightedEdgeStream>(path_graph);
     auto adjlist = make_shared<AdjacencyList>(is_directed);
 
     Aging2Experiment exp_aging;
@@ -45,7 +51,13 @@ void validate_aging2(bool is_directed, const string& path_graph, const string& p
 
     adjlist->dump();
 
-    stream = make_shared<WeightedEdgeStream>(path_graph);
+    validate_final_graph(adjlist.get(), path_graph);
+}
+
+// Check the graph in the library is the final graph of the log
+static
+void validate_final_graph(AdjacencyList* adjlist, const string& path_graph){
+    auto stream = make_shared<WeightedEdgeStream>(path_graph);
     unordered_set<uint64_t> vertices;
     for(uint64_t i = 0, sz = stream->num_edges(); i < sz; i++){
         auto edge = stream->get(i);
@@ -70,3 +82,79 @@ TEST(Aging2, Undirected){
     const string path_log = common::filesystem::directory_executable() + "/graphs/ldbc_graphalytics/example-undirected.graphlog";
     validate_aging2(/* is directed ? */ false, path_graph, path_log, 4);
 }
+
+// Slow down the updates, so that the experiment can be interrupted after its first checkpoints
+class SlowAdjacencyList : public AdjacencyList {
+public:
+    SlowAdjacencyList(bool is_directed) : AdjacencyList(is_directed) { }
+
+    virtual bool add_edge_v2(gfe::graph::WeightedEdge e){
+        this_thread::sleep_for(50ms);
+        return AdjacencyList::add_edge_v2(e);
+    }
+
+    virtual bool remove_edge(gfe::graph::Edge e){
+        this_thread::sleep_for(50ms);
+        return AdjacencyList::remove_edge(e);
+    }
+};
+
+// Get the path to non existing temporary file
+static string temp_file_path(){
+    char pattern[] = "/tmp/gfe_XXXXXX";
+    int fd = mkstemp(pattern);
+    if(fd < 0){ ERROR("Cannot obtain a temporary file"); }
+    close(fd); // we're going to overwrite this file anyway
+    return string(pattern);
+}
+
+/**
+ * Interrupt the experiment with the timeout after a few checkpoints, resume it in a new instance of the library and
+ * compare the final graph with the one of an uninterrupted run
+ */
+TEST(Aging2, Resume){
+    const string path_graph = common::filesystem::directory_executable() + "/graphs/ldbc_graphalytics/example-undirected.properties";
+    const string path_log = common::filesystem::directory_executable() + "/graphs/ldbc_graphalytics/example-undirected.graphlog";
+    const string path_checkpoint = temp_file_path();
+
+    { // the uninterrupted run
+        auto adjlist = make_shared<AdjacencyList>(/* directed ? */ false);
+        Aging2Experiment exp_aging;
+        exp_aging.set_library(adjlist);
+        exp_aging.set_log(path_log);
+        exp_aging.set_parallelism_degree(1);
+        exp_aging.set_worker_granularity(4);
+        exp_aging.execute();
+        validate_final_graph(adjlist.get(), path_graph);
+    }
+
+    { // the run interrupted by the timeout, a checkpoint is taken every second
+        auto adjlist = make_shared<SlowAdjacencyList>(/* directed ? */ false);
+        Aging2Experiment exp_aging;
+        exp_aging.set_library(adjlist);
+        exp_aging.set_log(path_log);
+        exp_aging.set_parallelism_degree(1);
+        exp_aging.set_worker_granularity(4);
+        exp_aging.set_checkpoint(path_checkpoint, 1s);
+        exp_aging.set_timeout(3s);
+        auto result = exp_aging.execute();
+        ASSERT_GT(exp_aging.num_operations_sofar(), 0);
+        ASSERT_LT(exp_aging.num_operations_sofar(), result.num_operations_total());
+    }
+
+    { // resume the run from the last checkpoint
+        auto adjlist = make_shared<AdjacencyList>(/* directed ? */ false);
+        Aging2Experiment exp_aging;
+        exp_aging.set_library(adjlist);
+        exp_aging.set_log(path_log);
+        exp_aging.set_parallelism_degree(1);
+        exp_aging.set_worker_granularity(4);
+        exp_aging.set_checkpoint(path_checkpoint, 1s);
+        exp_aging.set_resume(true);
+        exp_aging.execute();
+        validate_final_graph(adjlist.get(), path_graph);
+    }
+
+    remove(path_checkpoint.c_str());
+    remove((path_checkpoint + ".graph").c_str());
+}
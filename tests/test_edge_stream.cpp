@@ -96,3 +96,22 @@ TEST(EdgeStream, Sanity) {
 }
 
 
+
+TEST(EdgeStream, SortChunks) {
+    vector<WeightedEdge> edges;
+    for(uint64_t i = 0; i < 20; i++){ edges.push_back(WeightedEdge{ 20 - i, i + 100, (double) i }); }
+    WeightedEdgeStream stream(edges);
+
+    stream.sort_by_src_dst(/* chunk size */ 8);
+    ASSERT_EQ(stream.num_edges(), 20);
+
+    // each chunk is sorted by source, the edges never move across chunks
+    for(uint64_t i = 0; i < 20; i++){
+        uint64_t chunk_start = (i / 8) * 8;
+        uint64_t chunk_end = std::min<uint64_t>(chunk_start + 8, 20);
+        uint64_t expected_source = 20 - chunk_end + 1 + (i - chunk_start);
+        ASSERT_EQ(stream[i].source(), expected_source);
+        ASSERT_EQ(stream[i].destination(), 20 - expected_source + 100);
+        ASSERT_EQ(stream[i].weight(), 20 - expected_source);
+    }
+}
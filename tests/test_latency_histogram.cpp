@@ -0,0 +1,89 @@
+/**
+ * Copyright (C) 2019 Dean De Leo, email: dleo[at]cwi.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "gtest/gtest.h"
+
+#include <cinttypes>
+#include <cmath>
+
+#include "experiment/details/latency.hpp"
+
+using namespace gfe::experiment::details;
+using namespace std;
+
+// the relative error of the percentiles must be within 1/32
+static void assert_approx(uint64_t expected, uint64_t actual){
+    ASSERT_LE(fabs((double) actual - (double) expected), expected / 32.0 + 1) << "expected: " << expected << ", actual: " << actual;
+}
+
+TEST(LatencyHistogram, Empty){
+    LatencyHistogram histogram;
+    ASSERT_EQ(histogram.num_samples(), 0);
+    ASSERT_EQ(histogram.mean(), 0);
+    ASSERT_EQ(histogram.min(), 0);
+    ASSERT_EQ(histogram.max(), 0);
+    ASSERT_EQ(histogram.percentile(99), 0);
+}
+
+TEST(LatencyHistogram, SmallValues){
+    LatencyHistogram histogram;
+    for(uint64_t i = 1; i <= 10; i++){ histogram.record(i); }
+    ASSERT_EQ(histogram.num_samples(), 10);
+    ASSERT_EQ(histogram.mean(), 5);
+    ASSERT_EQ(histogram.min(), 1);
+    ASSERT_EQ(histogram.max(), 10);
+    ASSERT_EQ(histogram.percentile(50), 5); // values below 32 are exact
+    ASSERT_EQ(histogram.percentile(90), 9);
+    ASSERT_EQ(histogram.percentile(100), 10);
+}
+
+TEST(LatencyHistogram, Percentiles){
+    LatencyHistogram histogram;
+    const uint64_t N = 1000000;
+    for(uint64_t i = 1; i <= N; i++){ histogram.record(i * 10); }
+    ASSERT_EQ(histogram.num_samples(), N);
+    ASSERT_EQ(histogram.min(), 10);
+    ASSERT_EQ(histogram.max(), N * 10);
+    assert_approx(N * 5, histogram.mean());
+    assert_approx(N * 5, histogram.percentile(50));
+    assert_approx(N * 9, histogram.percentile(90));
+    assert_approx(N * 9.5, histogram.percentile(95));
+    assert_approx(N * 9.9, histogram.percentile(99));
+    assert_approx(N * 10, histogram.percentile(100));
+}
+
+TEST(LatencyHistogram, Merge){
+    LatencyHistogram h1, h2;
+    for(uint64_t i = 0; i < 1000; i++){
+        h1.record(100);
+        h2.record(chrono::microseconds(1));
+    }
+    h2.record(chrono::seconds(1));
+    h1.merge(h2);
+
+    ASSERT_EQ(h1.num_samples(), 2001);
+    ASSERT_EQ(h1.min(), 100);
+    ASSERT_EQ(h1.max(), 1000000000);
+    assert_approx(100, h1.percentile(40));
+    assert_approx(1000, h1.percentile(60));
+    assert_approx(1000000000, h1.percentile(100));
+
+    auto stats = LatencyStatistics::compute_statistics(h1);
+    assert_approx(1000, stats.percentile90().count());
+    assert_approx(1000, stats.percentile99().count());
+}
@@ -22,11 +22,14 @@
 #include <iostream>
 #include <string>
 
+#include "common/quantity.hpp"
 #include "common/system.hpp"
 #include "common/timer.hpp"
+#include "experiment/aging2_experiment.hpp"
 #include "experiment/insert_only.hpp"
 #include "graph/edge_stream.hpp"
 #include "library/baseline/adjacency_list.hpp"
+#include "library/baseline/dummy.hpp"
 
 #if defined(HAVE_LLAMA)
 #include "library/llama/llama_internal.hpp"
@@ -96,6 +99,47 @@ TEST(Performance, InsertOnly) {
     cout << "Execution completed in " << timer << "\n";
 }
 
+/**
+ * Microbenchmark, the overhead of the driver in the Aging2 experiment. All operations in the library `dummy' are nop, so
+ * the throughput observed is the max achievable by the driver with the given number of threads.
+ */
+TEST(Performance, Aging2DriverOverhead) {
+    auto impl = make_shared<Dummy>(is_directed);
+    Timer timer;
+    string path_graph = get_path_graph();
+
+    cout << "[Performance::Aging2DriverOverhead] Generating the updates from the graph `" << path_graph << "' ... \n";
+    timer.start();
+    auto synthetic_log = make_shared<details::SyntheticLog>(path_graph, SyntheticPattern::UNIFORM, /* aging coeff */ 10, /* seed */ 1910);
+    timer.stop();
+    cout << "Graph loaded in " << timer << ", number of updates: " << synthetic_log->num_operations() << "\n";
+
+    int num_threads = get_num_threads();
+    cout << "[Performance::Aging2DriverOverhead] Executing the updates using " << num_threads << " threads ...\n";
+    Aging2Experiment experiment;
+    experiment.set_library(impl);
+    experiment.set_synthetic_log(synthetic_log);
+    experiment.set_parallelism_degree(num_threads);
+    auto result = experiment.execute();
+
+    double ns_per_op = result.num_operations_total() > 0 ? 1000.0 * result.completion_time() * num_threads / result.num_operations_total() : 0;
+    double ops_per_sec = result.completion_time() > 0 ? 1000000.0 * result.num_operations_total() / result.completion_time() : 0;
+    cout << "Execution completed in " << DurationQuantity(result.completion_time() * 1000) << ", "
+            "throughput: " << static_cast<uint64_t>(ops_per_sec) << " ops/sec, overhead per operation: " << ns_per_op << " ns/thread\n";
+
+    // all updates must have been performed, and the time of each multiple of the final graph recorded
+    ASSERT_EQ(result.num_operations_total(), synthetic_log->num_operations());
+    ASSERT_EQ(experiment.num_operations_sofar(), synthetic_log->num_operations());
+    const auto& reported_times = result.reported_times();
+    ASSERT_EQ(reported_times.size(), synthetic_log->num_operations() / synthetic_log->num_edges_final());
+    uint64_t previous = 0;
+    for(uint64_t time : reported_times){
+        if(time == 0) continue; // not set, a multiple crossed within the same chunk of updates of the next one
+        ASSERT_GE(time, previous);
+        ASSERT_LE(time, result.completion_time());
+        previous = time;
+    }
+}
 
 TEST(Performance, LCC) {
     auto impl = make_shared<AdjacencyList>(is_directed);
@@ -0,0 +1,73 @@
+/**
+ * Copyright (C) 2019 Dean De Leo, email: dleo[at]cwi.nl
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <vector>
+
+#include "experiment/sliding_window.hpp"
+#include "graph/edge.hpp"
+#include "graph/edge_stream.hpp"
+#include "library/baseline/adjacency_list.hpp"
+
+using namespace gfe::experiment;
+using namespace gfe::graph;
+using namespace gfe::library;
+using namespace std;
+
+/**
+ * Stream `num_edges' distinct edges through a window of `window_size' edges. At the end of the last pass, the
+ * insertions minus the deletions must be equal to the size of the window, that is the graph must contain exactly the
+ * last `window_size' edges of the stream.
+ */
+static
+void validate_sliding_window(bool is_directed, uint64_t num_edges, uint64_t window_size, int64_t num_threads, uint64_t num_passes){
+    vector<WeightedEdge> edges;
+    for(uint64_t i = 0; i < num_edges; i++){
+        edges.emplace_back(/* source */ 1 + i % 64, /* destination */ 100 + i, /* weight */ i);
+    }
+    auto stream = make_shared<WeightedEdgeStream>(edges);
+    auto adjlist = make_shared<AdjacencyList>(is_directed);
+
+    SlidingWindow experiment { adjlist, stream, num_threads, window_size };
+    experiment.set_num_passes(num_passes);
+    experiment.execute();
+
+    ASSERT_EQ(adjlist->num_edges(), window_size);
+    for(uint64_t i = 0; i < num_edges; i++){
+        const WeightedEdge& edge = edges[i];
+        bool in_window = i >= num_edges - window_size;
+        ASSERT_EQ(adjlist->has_edge(edge.source(), edge.destination()), in_window) << "edge: " << edge << ", position: " << i;
+    }
+}
+
+TEST(SlidingWindow, SinglePass){
+    validate_sliding_window(/* directed ? */ true, /* num edges */ 4096, /* window size */ 1000, /* num threads */ 1, /* num passes */ 1);
+    validate_sliding_window(/* directed ? */ false, /* num edges */ 4096, /* window size */ 1000, /* num threads */ 1, /* num passes */ 1);
+}
+
+TEST(SlidingWindow, MultiplePasses){
+    validate_sliding_window(/* directed ? */ true, /* num edges */ 4096, /* window size */ 1000, /* num threads */ 1, /* num passes */ 3);
+    validate_sliding_window(/* directed ? */ false, /* num edges */ 4096, /* window size */ 1000, /* num threads */ 1, /* num passes */ 3);
+}
+
+TEST(SlidingWindow, Parallel){
+    validate_sliding_window(/* directed ? */ true, /* num edges */ 4096, /* window size */ 1000, /* num threads */ 8, /* num passes */ 1);
+    validate_sliding_window(/* directed ? */ false, /* num edges */ 4096, /* window size */ 1000, /* num threads */ 8, /* num passes */ 3);
+    validate_sliding_window(/* directed ? */ false, /* num edges */ 4096, /* window size */ 4000, /* num threads */ 8, /* num passes */ 2);
+}
@@ -241,6 +241,57 @@ static void parallel(shared_ptr<UpdateInterface> interface, uint64_t num_vertice
     interface->on_main_destroy();
 }
 
+// Apply the same sequence of updates to the interface with #update_batch and, one edge at a time, to a reference
+// adjacency list, then compare the two graphs
+static void batch_updates(shared_ptr<UpdateInterface> interface, uint64_t num_vertices = 128, uint64_t batch_size = 64){
+    interface->on_main_init(1);
+    interface->on_thread_init(0);
+
+    // insert all edges, remove one edge every three and insert back half of the removed edges with a new weight
+    auto edge_list = generate_edge_stream(num_vertices);
+    edge_list->permute();
+    vector<gfe::graph::WeightedEdge> updates;
+    for(uint64_t i = 0, sz = edge_list->num_edges(); i < sz; i++){
+        updates.push_back(edge_list->get(i));
+        if(i % 3 == 2){ // an edge inserted by the same or by the previous batch
+            auto edge = edge_list->get(i -1);
+            updates.push_back(gfe::graph::WeightedEdge{ edge.source(), edge.destination(), -1 });
+            if(i % 2 == 0){ updates.push_back(gfe::graph::WeightedEdge{ edge.source(), edge.destination(), edge.m_weight + 1 }); }
+        }
+    }
+
+    // the single edge path
+    auto reference = make_shared<AdjacencyList>(/* directed */ true);
+    for(const auto& update : updates){
+        if(update.m_weight >= 0){
+            ASSERT_TRUE(reference->add_edge_v2(update));
+        } else {
+            ASSERT_TRUE(reference->remove_edge(update.edge()));
+        }
+    }
+
+    // the batch path
+    for(uint64_t start = 0; start < updates.size(); start += batch_size){
+        interface->update_batch(updates.data() + start, min<uint64_t>(batch_size, updates.size() - start));
+    }
+    interface->build();
+
+    ASSERT_EQ(interface->num_edges(), reference->num_edges());
+    for(uint64_t i = 1; i < edge_list->max_vertex_id(); i++){
+        for(uint64_t j = 1; j < edge_list->max_vertex_id(); j++){
+            if(i == j) continue;
+            ASSERT_EQ(interface->has_edge(i, j), reference->has_edge(i, j));
+            if(reference->has_edge(i, j)){
+                ASSERT_EQ(interface->get_weight(i, j), reference->get_weight(i, j));
+            }
+        }
+    }
+
+    // done
+    interface->on_thread_destroy(0);
+    interface->on_main_destroy();
+}
+
 TEST(AdjacencyList, UpdatesDirected){
     auto adjlist = make_shared<AdjacencyList>(/* directed */ true);
     sequential(adjlist);
@@ -248,6 +299,10 @@ TEST(AdjacencyList, UpdatesDirected){
     parallel(adjlist, 1024);
 }
 
+TEST(AdjacencyList, UpdateBatchDirected){
+    batch_updates(make_shared<AdjacencyList>(/* directed */ true));
+}
+
 #if defined(HAVE_LLAMA)
 TEST(LLAMA, UpdatesDirected){
     auto llama = make_shared<LLAMAClass>(/* directed */ true);
@@ -265,4 +320,8 @@ TEST(LiveGraph, UpdatesDirected){
     parallel(livegraph, 128);
     parallel(livegraph, 1024);
 }
+
+TEST(LiveGraph, UpdateBatchDirected){
+    batch_updates(make_shared<LiveGraphDriver>(/* directed */ true));
+}
 #endif
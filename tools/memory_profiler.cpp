@@ -30,6 +30,7 @@
 #include <sys/mman.h>
 #include <sys/syscall.h>
 #include <unistd.h>
+#include <unordered_set>
 
 using namespace std;
 
@@ -43,15 +44,27 @@ static mutex g_mutex;
 static atomic<int64_t> g_next_thread_id = 0;
 static thread_local int g_thread_id = -1;
 static thread_local bool g_recursion = false; // whether we are calling the function from glibc (recursive call)
+static thread_local bool g_library_scope = false; // whether the current thread is executing the code of the library being evaluated, set by the driver
 static char g_popen_stmt[256] = {0}; // the statement to read the process mappings, set by #initialise_once
 
 static constexpr uint64_t num_entries = 1ull << 16;
 struct {
     int64_t m_size; // sum of allocated/free memory in the current thread
+    int64_t m_size_library; // sum of allocated/free memory in the current thread, while executing the code of the library
 } g_thread_local_entries[num_entries];
 static uint64_t g_memory_mappings[num_entries];
+static bool g_memory_mappings_library[num_entries]; // whether the memory mapping at the same position in g_memory_mappings was created by the library
 static uint64_t g_num_memory_mappings = 0;
 
+// The blocks allocated in the library scope. Their release is charged to the library, regardless of the scope of the
+// thread releasing them. The set is partitioned to reduce the contention among the threads.
+static constexpr uint64_t num_library_partitions = 256;
+struct LibraryBlocks {
+    mutex m_mutex;
+    unordered_set<uint64_t> m_blocks; // addresses of the blocks allocated in the library scope
+};
+static LibraryBlocks* g_library_blocks = nullptr; // created by #initialise_once, bypassing the hooks
+
 // real functions
 static void* (*glibc_malloc)(size_t sz) = nullptr;
 static void* (*glibc_calloc)(size_t num, size_t sz) = nullptr;
@@ -132,6 +145,7 @@ void initialise_once(){
     }
 
     memset(g_thread_local_entries, '\0', num_entries * sizeof(g_thread_local_entries[0]));
+    g_library_blocks = new LibraryBlocks[num_library_partitions]; // never released
 
     unsetenv("LD_PRELOAD"); // reset the env. var. used to load this library
 
@@ -167,11 +181,22 @@ struct RecursionGuard {
  *                                                                           *
  *****************************************************************************/
 
+static LibraryBlocks& library_blocks(void* pointer){
+    return g_library_blocks[ (reinterpret_cast<uint64_t>(pointer) >> 4) % num_library_partitions ]; // the blocks are aligned to 16 bytes
+}
+
 static void handle_malloc(void* pointer, uint64_t requested_size){
     if(pointer == nullptr) return; // nop
 
     int64_t allocated_size = reinterpret_cast<uint64_t*>(pointer)[-1] & MASK_MALLOC_SIZE;
-    g_thread_local_entries[g_thread_id].m_size += allocated_size;
+    if(g_library_scope){
+        g_thread_local_entries[g_thread_id].m_size_library += allocated_size;
+        LibraryBlocks& partition = library_blocks(pointer);
+        scoped_lock<mutex> lock(partition.m_mutex);
+        partition.m_blocks.insert(reinterpret_cast<uint64_t>(pointer));
+    } else {
+        g_thread_local_entries[g_thread_id].m_size += allocated_size;
+    }
 
     // printf("[malloc] pointer: %p, requested_size: %lu, allocated size: %lld\n", pointer, requested_size, allocated_size);
 }
@@ -180,7 +205,20 @@ static void handle_free(void* pointer){
     if(pointer == nullptr) return; // nop
 
     int64_t allocated_size = reinterpret_cast<uint64_t*>(pointer)[-1] & MASK_MALLOC_SIZE;
-    g_thread_local_entries[g_thread_id].m_size -= allocated_size;
+
+    // charge the release to the scope where the block was allocated
+    bool library_scope = false;
+    {
+        LibraryBlocks& partition = library_blocks(pointer);
+        scoped_lock<mutex> lock(partition.m_mutex);
+        library_scope = partition.m_blocks.erase(reinterpret_cast<uint64_t>(pointer)) > 0;
+    }
+
+    if(library_scope){
+        g_thread_local_entries[g_thread_id].m_size_library -= allocated_size;
+    } else {
+        g_thread_local_entries[g_thread_id].m_size -= allocated_size;
+    }
 
     // printf("[free] pointer: %p, allocated size: %ld\n", pointer, allocated_size);
 }
@@ -197,9 +235,11 @@ static void handle_mmap(void* pointer){
     int64_t i = g_num_memory_mappings;
     while(i > 0 && g_memory_mappings[i -1] > address){
         g_memory_mappings[i] = g_memory_mappings[i -1];
+        g_memory_mappings_library[i] = g_memory_mappings_library[i -1];
         i--;
     }
     g_memory_mappings[i] = address;
+    g_memory_mappings_library[i] = g_library_scope;
 
     g_num_memory_mappings++;
 }
@@ -230,6 +270,7 @@ static void handle_munmap(void* pointer){
 
    while(i < num_memory_mappings){
        g_memory_mappings[i] = g_memory_mappings[i+1];
+       g_memory_mappings_library[i] = g_memory_mappings_library[i+1];
        i++;
    }
 
@@ -271,7 +312,7 @@ void* realloc(void* ptr, size_t size){
 
     handle_free(ptr);
     void* ret = glibc_realloc(ptr, size);
-    handle_malloc(ptr, size);
+    handle_malloc(ret, size);
 
     return ret;
 }
@@ -328,14 +369,20 @@ int munmap(void *addr, size_t length){
  *****************************************************************************/
 extern "C" { // avoid mangling
 
-int64_t gfe_compute_memory_footprint (){
+void gfe_set_library_scope (bool value){
+    g_library_scope = value;
+}
+
+int64_t gfe_compute_memory_footprint_v2 (int64_t* out_library){
     unique_lock<mutex> xlock(g_mutex);
     int64_t memfp = 0;
+    int64_t memfp_library = 0;
 
     // count the virtual memory allocated by glibc
     int64_t num_entries = g_next_thread_id;
     for(int64_t i = 0; i < num_entries; i++){
-        memfp += g_thread_local_entries[i].m_size;
+        memfp += g_thread_local_entries[i].m_size + g_thread_local_entries[i].m_size_library;
+        memfp_library += g_thread_local_entries[i].m_size_library;
     }
 
     // count the amount of physical memory used by the memory mappings
@@ -360,13 +407,19 @@ int64_t gfe_compute_memory_footprint (){
             uint64_t rss = strtoull(next, nullptr, 10) * /* KB */ 1024ull;
             //printf("address: %" PRIu64 ", rss: %" PRIu64 "\n", address, rss);
 
+            if(g_memory_mappings_library[g_next_mapping]){ memfp_library += rss; }
             g_next_mapping++;
             memfp += rss;
         }
     }
     pclose(fp);
 
+    if(out_library != nullptr){ *out_library = memfp_library; }
     return memfp;
 }
 
+int64_t gfe_compute_memory_footprint (){
+    return gfe_compute_memory_footprint_v2(nullptr);
+}
+
 } // extern "C"
@@ -41,6 +41,10 @@ static const char* DEFAULT_LIBRARY_NAME_MEMORY_PROFILER = "gfe_memory_profiler.s
 
 // Pointer to the actual routine to compute the memory footprint
 static int64_t (*fn_compute_memory_footprint) () = nullptr;
+static int64_t (*fn_compute_memory_footprint_v2) (int64_t* /* out_library */) = nullptr;
+
+// Pointer to the actual routine to set the scope (library/driver) of the allocations of the calling thread
+static void (*fn_set_library_scope) (bool) = nullptr;
 
 namespace gfe::utility {
 
@@ -109,6 +113,9 @@ void MemoryUsage::initialise(int argc, char* argv[]){
 bool MemoryUsage::is_initialised() {
     if(fn_compute_memory_footprint == nullptr){
         fn_compute_memory_footprint = reinterpret_cast<decltype(fn_compute_memory_footprint)>(dlsym(RTLD_DEFAULT, "gfe_compute_memory_footprint"));
+        // older versions of the profiler do not provide the breakdown library/driver
+        fn_compute_memory_footprint_v2 = reinterpret_cast<decltype(fn_compute_memory_footprint_v2)>(dlsym(RTLD_DEFAULT, "gfe_compute_memory_footprint_v2"));
+        fn_set_library_scope = reinterpret_cast<decltype(fn_set_library_scope)>(dlsym(RTLD_DEFAULT, "gfe_set_library_scope"));
     }
 
     return fn_compute_memory_footprint != nullptr;
@@ -122,6 +129,19 @@ int64_t MemoryUsage::memory_footprint(){
     }
 }
 
+int64_t MemoryUsage::memory_footprint(int64_t* out_library){
+    if(fn_compute_memory_footprint_v2 != nullptr){
+        return fn_compute_memory_footprint_v2(out_library);
+    } else {
+        if(out_library != nullptr){ *out_library = 0; }
+        return memory_footprint();
+    }
+}
+
+void MemoryUsage::set_library_scope(bool value){
+    if(fn_set_library_scope != nullptr){ fn_set_library_scope(value); }
+}
+
 uint64_t MemoryUsage::get_allocated_space(const void* pointer){
     if(pointer == nullptr) return 0;
     return reinterpret_cast<const uint64_t*>(pointer)[-1] & /* glibc flags */ ~7ull;
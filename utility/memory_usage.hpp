@@ -51,6 +51,22 @@ public:
      */
     static int64_t memory_footprint();
 
+    /**
+     * Compute the memory footprint of this process, as #memory_footprint(), and the share of the footprint allocated
+     * while the threads were executing the library code, as delimited by #set_library_scope.
+     * The deallocations are accounted to the scope of the thread releasing the memory, thus the share is an approximation
+     * when the same memory is allocated by the library and released by the driver, or vice versa.
+     */
+    static int64_t memory_footprint(int64_t* out_library);
+
+    /**
+     * Set whether the calling thread is executing the code of the library being evaluated. The allocations and deallocations
+     * performed in the meanwhile are accounted to the library, rather than to the driver.
+     *
+     * The function is a nop if the class has not been previously initialised.
+     */
+    static void set_library_scope(bool value);
+
     /**
      * Get the virtual space used by the given allocation, assuming the allocation has been made by glibc
      */